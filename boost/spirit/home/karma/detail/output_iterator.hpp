@@ -17,6 +17,8 @@
 #include <boost/config.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
 
 #include <boost/spirit/home/karma/generator.hpp>
 #include <boost/spirit/home/support/iterators/ostream_iterator.hpp>
@@ -166,10 +168,52 @@ namespace boost { namespace spirit { namespace karma { namespace detail
         void output(T const& /*value*/) {}
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    //  The character type the buffered output is stored as: the value type of
+    //  the user supplied output iterator if it is known and integral, and
+    //  wchar_t otherwise.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    struct buffer_char_type
+      : mpl::if_<is_integral<T>, T, wchar_t>
+    {};
+
+    template <typename OutputIterator>
+    struct sink_char_type
+    {
+        typedef wchar_t type;
+    };
+
+    template <typename T>
+    struct sink_char_type<T*>
+      : buffer_char_type<T>
+    {};
+
+    template <typename Container>
+    struct sink_char_type<std::back_insert_iterator<Container> >
+      : buffer_char_type<typename Container::value_type>
+    {};
+
+    template <typename T, typename Elem, typename Traits>
+    struct sink_char_type<std::ostream_iterator<T, Elem, Traits> >
+      : buffer_char_type<T>
+    {};
+
+    template <typename Elem, typename Traits>
+    struct sink_char_type<std::ostreambuf_iterator<Elem, Traits> >
+      : buffer_char_type<Elem>
+    {};
+
+    template <typename T, typename Elem, typename Traits>
+    struct sink_char_type<karma::ostream_iterator<T, Elem, Traits> >
+      : buffer_char_type<T>
+    {};
+
     ///////////////////////////////////////////////////////////////////////////
     //  The following classes are used to intercept the output into a buffer
     //  allowing to do things like alignment, character escaping etc.
     ///////////////////////////////////////////////////////////////////////////
+    template <typename Char>
     class buffer_sink : boost::noncopyable
     {
     public:
@@ -197,10 +241,17 @@ namespace boost { namespace spirit { namespace karma { namespace detail
         template <typename T>
         void output(T const& value)
         {
-            BOOST_STATIC_ASSERT(sizeof(T) <= sizeof(wchar_t));
+            BOOST_STATIC_ASSERT(sizeof(T) <= sizeof(Char) || 
+                !is_same<Char, wchar_t>::value);
             buffer.push_back(value);
         }
 
+        template <typename T>
+        void output(T const* first, T const* last)
+        {
+            buffer.insert(buffer.end(), first, last);
+        }
+
         template <typename OutputIterator_>
         bool copy(OutputIterator_& sink, std::size_t maxwidth) const 
         { 
@@ -208,7 +259,7 @@ namespace boost { namespace spirit { namespace karma { namespace detail
 #pragma warning(push)
 #pragma warning(disable: 4267)
 #endif
-            typename std::basic_string<wchar_t>::const_iterator end = 
+            typename std::vector<Char>::const_iterator end = 
                 buffer.begin() + (std::min)(buffer.size(), maxwidth);
 
 #if defined(BOOST_MSVC)
@@ -224,7 +275,7 @@ namespace boost { namespace spirit { namespace karma { namespace detail
 #pragma warning(push)
 #pragma warning(disable: 4267)
 #endif
-            typename std::basic_string<wchar_t>::const_iterator begin = 
+            typename std::vector<Char>::const_iterator begin = 
                 buffer.begin() + (std::min)(buffer.size(), start_at);
 
 #if defined(BOOST_MSVC)
@@ -234,6 +285,17 @@ namespace boost { namespace spirit { namespace karma { namespace detail
             return true;
         }
 
+        // copy the buffered characters into one of our output iterators 
+        // at once
+        template <typename OutputIterator_>
+        bool copy_range(OutputIterator_& sink, std::size_t maxwidth) const 
+        { 
+            std::size_t const size = (std::min)(buffer.size(), maxwidth);
+            if (size != 0)
+                sink.output(&buffer[0], &buffer[0] + size);
+            return true;
+        }
+
         std::size_t buffer_size() const 
         { 
             return buffer.size();
@@ -241,20 +303,23 @@ namespace boost { namespace spirit { namespace karma { namespace detail
 
     private:
         std::size_t width;
-        std::basic_string<wchar_t> buffer;
+        std::vector<Char> buffer;
     };
 
     ///////////////////////////////////////////////////////////////////////////
+    template <typename Char>
     struct buffering_policy
     {
     public:
+        typedef buffer_sink<Char> buffer_type;
+
         buffering_policy() : buffer(NULL) {}
         buffering_policy(buffering_policy const& rhs) : buffer(rhs.buffer) {}
 
         // functions related to buffering
-        buffer_sink* chain_buffering(buffer_sink* buffer_data)
+        buffer_type* chain_buffering(buffer_type* buffer_data)
         {
-            buffer_sink* prev_buffer = buffer;
+            buffer_type* prev_buffer = buffer;
             buffer = buffer_data;
             return prev_buffer;
         }
@@ -270,10 +335,20 @@ namespace boost { namespace spirit { namespace karma { namespace detail
             return true;
         }
 
+        template <typename T>
+        bool output(T const* first, T const* last) 
+        { 
+            if (NULL != buffer) {
+                buffer->output(first, last);
+                return false;
+            }
+            return true;
+        }
+
         bool has_buffer() const { return NULL != buffer; }
 
     private:
-        buffer_sink* buffer;
+        buffer_type* buffer;
     };
 
     struct no_buffering_policy
@@ -287,9 +362,57 @@ namespace boost { namespace spirit { namespace karma { namespace detail
             return true;
         }
 
+        template <typename T>
+        bool output(T const* /*first*/, T const* /*last*/) 
+        {
+            return true;
+        }
+
         bool has_buffer() const { return false; }
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    //  Write a range of characters to the user supplied output iterator. 
+    //  Strings and vectors filled through a std::back_insert_iterator get 
+    //  the whole range appended at once, pointers are written with a single 
+    //  std::copy.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Container>
+    struct back_insert_container
+      : std::back_insert_iterator<Container>
+    {
+        static Container& get(std::back_insert_iterator<Container>& it)
+        {
+            return *(it.*(&back_insert_container::container));
+        }
+    };
+
+    template <typename OutputIterator, typename T>
+    inline void sink_write(OutputIterator& sink, T const* first, T const* last)
+    {
+        sink = std::copy(first, last, sink);
+    }
+
+    template <typename Char, typename Traits, typename Allocator, typename T>
+    inline void sink_write(
+        std::back_insert_iterator<std::basic_string<Char, Traits, Allocator> >& 
+            sink
+      , T const* first, T const* last)
+    {
+        typedef std::basic_string<Char, Traits, Allocator> container_type;
+        back_insert_container<container_type>::get(sink).append(first, last);
+    }
+
+    template <typename U, typename Allocator, typename T>
+    inline void sink_write(
+        std::back_insert_iterator<std::vector<U, Allocator> >& sink
+      , T const* first, T const* last)
+    {
+        typedef std::vector<U, Allocator> container_type;
+        container_type& c = back_insert_container<container_type>::get(sink);
+        c.insert(c.end(), first, last);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     //  forward declaration only
     template <typename OutputIterator> 
@@ -319,6 +442,17 @@ namespace boost { namespace spirit { namespace karma { namespace detail
             this->tracking_policy::output(value);
             return this->buffering_policy::output(value);
         }
+
+        template <typename T>
+        bool output(T const* first, T const* last) 
+        { 
+            for (T const* it = first; it != last; ++it)
+            {
+                this->counting_policy::output(*it);
+                this->tracking_policy::output(*it);
+            }
+            return this->buffering_policy::output(first, last);
+        }
     };
 
     template <typename Buffering, typename Counting, typename Tracking>
@@ -345,6 +479,20 @@ namespace boost { namespace spirit { namespace karma { namespace detail
             return this->buffering_policy::output(value);
         }
 
+        template <typename T>
+        bool output(T const* first, T const* last) 
+        { 
+            if (!do_output) 
+                return false;
+
+            for (T const* it = first; it != last; ++it)
+            {
+                this->counting_policy::output(*it);
+                this->tracking_policy::output(*it);
+            }
+            return this->buffering_policy::output(first, last);
+        }
+
         bool do_output;
     };
 
@@ -367,7 +515,8 @@ namespace boost { namespace spirit { namespace karma { namespace detail
 
         typedef typename mpl::if_c<
             (properties & generator_properties::buffering) ? true : false
-          , buffering_policy, no_buffering_policy
+          , buffering_policy<typename sink_char_type<OutputIterator>::type>
+          , no_buffering_policy
         >::type buffering_type;
 
         typedef typename mpl::if_c<
@@ -449,6 +598,14 @@ namespace boost { namespace spirit { namespace karma { namespace detail
 #pragma warning (pop)
 #endif
 
+        // output a range of characters at once
+        template <typename T>
+        void output(T const* first, T const* last)
+        {
+            if (this->base_iterator::output(first, last))
+                detail::sink_write(*sink, first, last);
+        }
+
         // plain output iterators are considered to be good all the time
         bool good() const { return true; }
 
@@ -518,6 +675,8 @@ namespace boost { namespace spirit { namespace karma { namespace detail
     template <typename OutputIterator>
     struct enable_buffering
     {
+        typedef typename OutputIterator::buffer_type buffer_type;
+
         enable_buffering(OutputIterator& sink_
               , std::size_t width = std::size_t(-1))
           : sink(sink_), prev_buffer(NULL), enabled(false)
@@ -546,7 +705,7 @@ namespace boost { namespace spirit { namespace karma { namespace detail
         {
             if (disable_)
                 disable();
-            return buffer_data.copy(sink, maxwidth) && sink.good();
+            return buffer_data.copy_range(sink, maxwidth) && sink.good();
         }
 
         // return number of characters stored in the buffer
@@ -572,8 +731,8 @@ namespace boost { namespace spirit { namespace karma { namespace detail
 
     private:
         OutputIterator& sink;
-        buffer_sink buffer_data;    // for buffering
-        buffer_sink* prev_buffer;   // previous buffer in chain
+        buffer_type buffer_data;    // for buffering
+        buffer_type* prev_buffer;   // previous buffer in chain
         bool enabled;
     };
 
@@ -610,6 +769,28 @@ namespace boost { namespace spirit { namespace karma { namespace detail
         return sink.good(); // our own output iterators are handled separately
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    //  Output a range of characters, our own output iterators take the range 
+    //  at once
+    template <typename OutputIterator, typename T>
+    inline void output_range(OutputIterator& sink, T const* first, T const* last)
+    {
+        for (/**/; first != last; ++first)
+        {
+            *sink = *first;
+            ++sink;
+        }
+    }
+
+    template <typename OutputIterator, typename Properties, typename Derived
+      , typename T>
+    inline void output_range(
+        output_iterator<OutputIterator, Properties, Derived>& sink
+      , T const* first, T const* last)
+    {
+        sink.output(first, last);
+    }
+
 }}}}
 
 #endif 
@@ -52,6 +52,18 @@ namespace boost { namespace spirit { namespace karma { namespace detail
         return detail::sink_is_good(sink);
     }
 
+    template <typename OutputIterator, typename Char>
+    inline bool string_generate(OutputIterator& sink, Char const* str
+      , pass_through_filter)
+    {
+        Char const* end = str;
+        while (*end != 0)
+            ++end;
+
+        detail::output_range(sink, str, end);
+        return detail::sink_is_good(sink);
+    }
+
     template <typename OutputIterator, typename Container, typename Filter>
     inline bool string_generate(OutputIterator& sink
       , Container const& c, Filter filter)
@@ -124,6 +136,35 @@ namespace boost { namespace spirit { namespace karma { namespace detail
         return string_generate(sink, c, encoding_filter<CharEncoding, Tag>());
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    //  generate a string without case conversion (unused_type as the Tag) 
+    //  without any transformation
+    template <typename OutputIterator, typename Char, typename CharEncoding>
+    inline bool string_generate(OutputIterator& sink
+      , Char const* str
+      , CharEncoding, unused_type)
+    {
+        return string_generate(sink, str, pass_through_filter());
+    }
+
+    template <typename OutputIterator, typename Char, typename CharEncoding
+      , typename Traits, typename Allocator>
+    inline bool string_generate(OutputIterator& sink
+      , std::basic_string<Char, Traits, Allocator> const& str
+      , CharEncoding, unused_type)
+    {
+        return string_generate(sink, str.c_str(), pass_through_filter());
+    }
+
+    template <typename OutputIterator, typename Container
+      , typename CharEncoding>
+    inline bool string_generate(OutputIterator& sink
+      , Container const& c
+      , CharEncoding, unused_type)
+    {
+        return string_generate(sink, c, pass_through_filter());
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename OutputIterator, typename Char>
     inline bool string_generate(OutputIterator& sink
@@ -11,6 +11,7 @@
 #endif
 
 #include <boost/spirit/home/karma/nonterminal/rule.hpp>
+#include <boost/spirit/home/karma/nonterminal/static_rule.hpp>
 #include <boost/spirit/home/karma/nonterminal/grammar.hpp>
 #include <boost/spirit/home/karma/nonterminal/debug_handler.hpp>
 #include <boost/spirit/home/karma/nonterminal/simple_trace.hpp>
@@ -0,0 +1,306 @@
+//  Copyright (c) 2001-2011 Joel de Guzman
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(BOOST_SPIRIT_KARMA_STATIC_RULE_OCT_16_2026_0215PM)
+#define BOOST_SPIRIT_KARMA_STATIC_RULE_OCT_16_2026_0215PM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+
+#include <boost/spirit/home/support/unused.hpp>
+#include <boost/spirit/home/support/info.hpp>
+#include <boost/spirit/home/support/assert_msg.hpp>
+#include <boost/spirit/home/karma/meta_compiler.hpp>
+#include <boost/spirit/home/karma/reference.hpp>
+#include <boost/spirit/home/karma/detail/output_iterator.hpp>
+#include <boost/spirit/home/karma/delimit_out.hpp>
+#include <boost/spirit/home/karma/nonterminal/rule.hpp>
+#include <boost/spirit/home/karma/nonterminal/detail/generator_binder.hpp>
+#include <boost/spirit/home/karma/nonterminal/detail/parameterized.hpp>
+
+#if defined(BOOST_MSVC)
+# pragma warning(push)
+# pragma warning(disable: 4355) // 'this' : used in base member initializer list warning
+#endif
+
+namespace boost { namespace spirit { namespace karma
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  static_rule is a rule whose right hand side is part of its type (see
+    //  qi::static_rule). The compiled generator is stored in place of the
+    //  boost::function used by karma::rule, so invoking it can be inlined.
+    //  It uses the same (wrapped) output iterator as karma::rule, which
+    //  allows both to refer to each other freely.
+    ///////////////////////////////////////////////////////////////////////////
+    template <
+        typename OutputIterator, typename Expr, typename T1 = unused_type
+      , typename T2 = unused_type, typename T3 = unused_type
+      , typename T4 = unused_type>
+    struct static_rule
+      : proto::extends<
+            typename proto::terminal<
+                reference<
+                    static_rule<OutputIterator, Expr, T1, T2, T3, T4> const>
+            >::type
+          , static_rule<OutputIterator, Expr, T1, T2, T3, T4>
+        >
+      , generator<static_rule<OutputIterator, Expr, T1, T2, T3, T4> >
+    {
+        typedef mpl::int_<generator_properties::all_properties> properties;
+
+        typedef OutputIterator iterator_type;
+        typedef static_rule<OutputIterator, Expr, T1, T2, T3, T4> this_type;
+        typedef reference<this_type const> reference_;
+        typedef typename proto::terminal<reference_>::type terminal;
+        typedef proto::extends<terminal, this_type> base_type;
+
+        // The equivalent karma::rule, used to extract the rule's properties
+        typedef rule<OutputIterator, T1, T2, T3, T4> rule_type;
+
+        typedef typename rule_type::output_iterator output_iterator;
+        typedef typename rule_type::locals_type locals_type;
+        typedef typename rule_type::delimiter_type delimiter_type;
+        typedef typename rule_type::sig_type sig_type;
+        typedef typename rule_type::encoding_type encoding_type;
+        typedef typename rule_type::attr_type attr_type;
+        typedef typename rule_type::parameter_types parameter_types;
+        typedef typename rule_type::context_type context_type;
+        typedef typename rule_type::encoding_modifier_type
+            encoding_modifier_type;
+
+        static size_t const params_size = rule_type::params_size;
+
+        // The right hand side generator, bound as done by the constructor
+        // of karma::rule
+        typedef typename
+            result_of::compile<karma::domain, Expr, encoding_modifier_type>::type
+        subject_type;
+        typedef detail::generator_binder<subject_type, mpl::false_>
+            binder_type;
+
+        explicit static_rule(Expr const& expr
+              , std::string const& name_ = "unnamed-rule")
+          : base_type(terminal::make(reference_(*this)))
+          , name_(name_)
+          , binder(compile<karma::domain>(expr, encoding_modifier_type()))
+        {
+            // Report invalid expression error as early as possible.
+            // If you got an error_invalid_expression error message here, then
+            // the expression (expr) is not a valid spirit karma expression.
+            BOOST_SPIRIT_ASSERT_MATCH(karma::domain, Expr);
+        }
+
+        static_rule(static_rule const& rhs)
+          : base_type(terminal::make(reference_(*this)))
+          , name_(rhs.name_)
+          , binder(rhs.binder)
+        {
+        }
+
+        static_rule& operator=(static_rule const& rhs)
+        {
+            binder = rhs.binder;
+            name_ = rhs.name_;
+            return *this;
+        }
+
+        std::string const& name() const
+        {
+            return name_;
+        }
+
+        void name(std::string const& str)
+        {
+            name_ = str;
+        }
+
+        template <typename Context, typename Unused>
+        struct attribute
+        {
+            typedef attr_type type;
+        };
+
+        template <typename Context, typename Delimiter, typename Attribute>
+        bool generate(output_iterator& sink, Context&, Delimiter const& delim
+          , Attribute const& attr) const
+        {
+            // If you are seeing a compilation error here, you are probably
+            // trying to use a rule with an incompatible delimiter type.
+            BOOST_SPIRIT_ASSERT_MSG(
+                (is_convertible<Delimiter const&, delimiter_type>::value)
+              , incompatible_delimiter_type, (Delimiter));
+
+            // Create an attribute if none is supplied.
+            typedef traits::make_attribute<attr_type, Attribute>
+                make_attribute;
+            typedef traits::transform_attribute<
+                typename make_attribute::type, attr_type, domain>
+            transform;
+
+            typename transform::type attr_ =
+                traits::pre_transform<domain, attr_type>(
+                    make_attribute::call(attr));
+
+            // If you are seeing a compilation error here, you are probably
+            // trying to use a rule which has inherited attributes, without
+            // passing values for them.
+            context_type context(attr_);
+
+            // the right hand side is invoked with the rule's delimiter as
+            // done by karma::rule (unused_type makes the rule an implied
+            // verbatim)
+            delimiter_type const& rule_delim = delim;
+            if (binder(sink, context, rule_delim))
+            {
+                // do a post-delimit if this is an implied verbatim
+                if (is_same<delimiter_type, unused_type>::value)
+                    karma::delimit_out(sink, delim);
+
+                return true;
+            }
+            return false;
+        }
+
+        template <typename Context, typename Delimiter, typename Attribute
+          , typename Params>
+        bool generate(output_iterator& sink, Context& caller_context
+          , Delimiter const& delim, Attribute const& attr
+          , Params const& params) const
+        {
+            // If you are seeing a compilation error here, you are probably
+            // trying to use a rule with an incompatible delimiter type.
+            BOOST_SPIRIT_ASSERT_MSG(
+                (is_convertible<Delimiter const&, delimiter_type>::value)
+              , incompatible_delimiter_type, (Delimiter));
+
+            // Create an attribute if none is supplied.
+            typedef traits::make_attribute<attr_type, Attribute>
+                make_attribute;
+            typedef traits::transform_attribute<
+                typename make_attribute::type, attr_type, domain>
+            transform;
+
+            typename transform::type attr_ =
+                traits::pre_transform<domain, attr_type>(
+                    make_attribute::call(attr));
+
+            // If you are seeing a compilation error here, you are probably
+            // trying to use a rule which has inherited attributes, passing
+            // values of incompatible types for them.
+            context_type context(attr_, params, caller_context);
+
+            // the right hand side is invoked with the rule's delimiter as
+            // done by karma::rule (unused_type makes the rule an implied
+            // verbatim)
+            delimiter_type const& rule_delim = delim;
+            if (binder(sink, context, rule_delim))
+            {
+                // do a post-delimit if this is an implied verbatim
+                if (is_same<delimiter_type, unused_type>::value)
+                    karma::delimit_out(sink, delim);
+
+                return true;
+            }
+            return false;
+        }
+
+        template <typename Context>
+        info what(Context& /*context*/) const
+        {
+            return info(name_);
+        }
+
+        reference_ alias() const
+        {
+            return reference_(*this);
+        }
+
+        // bring in the operator() overloads
+        static_rule const& get_parameterized_subject() const { return *this; }
+        typedef static_rule parameterized_subject_type;
+        #include <boost/spirit/home/karma/nonterminal/detail/fcall.hpp>
+
+        std::string name_;
+        binder_type binder;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  Generator functions for static_rule, deducing the expression type:
+    //
+    //      BOOST_AUTO(r, karma::make_static_rule<OutputIterator, int()>(expr));
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename OutputIterator, typename Expr>
+    inline static_rule<OutputIterator, Expr>
+    make_static_rule(Expr const& expr
+      , std::string const& name = "unnamed-rule")
+    {
+        return static_rule<OutputIterator, Expr>(expr, name);
+    }
+
+    template <typename OutputIterator, typename T1, typename Expr>
+    inline static_rule<OutputIterator, Expr, T1>
+    make_static_rule(Expr const& expr
+      , std::string const& name = "unnamed-rule")
+    {
+        return static_rule<OutputIterator, Expr, T1>(expr, name);
+    }
+
+    template <typename OutputIterator, typename T1, typename T2
+      , typename Expr>
+    inline static_rule<OutputIterator, Expr, T1, T2>
+    make_static_rule(Expr const& expr
+      , std::string const& name = "unnamed-rule")
+    {
+        return static_rule<OutputIterator, Expr, T1, T2>(expr, name);
+    }
+
+    template <typename OutputIterator, typename T1, typename T2
+      , typename T3, typename Expr>
+    inline static_rule<OutputIterator, Expr, T1, T2, T3>
+    make_static_rule(Expr const& expr
+      , std::string const& name = "unnamed-rule")
+    {
+        return static_rule<OutputIterator, Expr, T1, T2, T3>(expr, name);
+    }
+
+    template <typename OutputIterator, typename T1, typename T2
+      , typename T3, typename T4, typename Expr>
+    inline static_rule<OutputIterator, Expr, T1, T2, T3, T4>
+    make_static_rule(Expr const& expr
+      , std::string const& name = "unnamed-rule")
+    {
+        return static_rule<OutputIterator, Expr, T1, T2, T3, T4>(expr, name);
+    }
+}}}
+
+namespace boost { namespace spirit { namespace traits
+{
+    ///////////////////////////////////////////////////////////////////////////
+    template <
+        typename IteratorA, typename IteratorB, typename Attribute
+      , typename Context, typename Expr, typename T1, typename T2
+      , typename T3, typename T4>
+    struct handles_container<
+            karma::static_rule<IteratorA, Expr, T1, T2, T3, T4>, Attribute
+          , Context, IteratorB>
+      : detail::nonterminal_handles_container<
+            typename attribute_of<
+                karma::static_rule<IteratorA, Expr, T1, T2, T3, T4>
+              , Context, IteratorB
+          >::type, Attribute>
+    {};
+}}}
+
+#if defined(BOOST_MSVC)
+# pragma warning(pop)
+#endif
+
+#endif
@@ -15,6 +15,9 @@
 #include <limits>
 
 #include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
+#include <boost/mpl/bool.hpp>
 #include <boost/spirit/home/support/char_class.hpp>
 #include <boost/spirit/home/support/unused.hpp>
 #include <boost/spirit/home/support/detail/pow10.hpp>
@@ -345,6 +348,24 @@ namespace boost { namespace spirit { namespace karma
             }
         };
 
+        ///////////////////////////////////////////////////////////////////////
+        //  The decimal representations of 00 to 99
+        inline char const* digit_pairs()
+        {
+            static char const pairs[] =
+                "00010203040506070809"
+                "10111213141516171819"
+                "20212223242526272829"
+                "30313233343536373839"
+                "40414243444546474849"
+                "50515253545556575859"
+                "60616263646566676869"
+                "70717273747576777879"
+                "80818283848586878889"
+                "90919293949596979899";
+            return pairs;
+        }
+
         ///////////////////////////////////////////////////////////////////////
         template <unsigned Radix>
         struct divide
@@ -446,6 +467,9 @@ namespace boost { namespace spirit { namespace karma
     //      string length (complete unrolling). 
     //      If not specified, this value defaults to 6.
     //
+    //  Decimal integers don't use this loop, these are generated two digits
+    //  at a time using a lookup table.
+    //
     ///////////////////////////////////////////////////////////////////////////
 #define BOOST_KARMA_NUMERICS_INNER_LOOP_PREFIX(z, x, data)                    \
         if (!detail::is_zero(n)) {                                            \
@@ -471,6 +495,52 @@ namespace boost { namespace spirit { namespace karma
         template <typename OutputIterator, typename T>
         static bool
         call(OutputIterator& sink, T n, T& num, int exp)
+        {
+            return call(sink, n, num, exp, mpl::bool_<
+                Radix == 10 && is_integral<T>::value && 
+                !is_same<T, bool>::value>());
+        }
+
+        // Decimal integers are converted two digits at a time into a buffer
+        // which is copied to the output afterwards (the digits are not 
+        // affected by the CharEncoding and Tag).
+        template <typename OutputIterator, typename T>
+        static bool
+        call(OutputIterator& sink, T n, T&, int, mpl::true_)
+        {
+            typedef typename make_unsigned<T>::type unsigned_type;
+            unsigned_type un = unsigned_type(n);
+
+            char buffer[std::numeric_limits<unsigned_type>::digits10 + 1];
+            char* const end = buffer + sizeof(buffer);
+            char* p = end;
+
+            char const* pairs = detail::digit_pairs();
+            while (un >= 100)
+            {
+                char const* pair = pairs + 2 * unsigned(un % 100);
+                un /= 100;
+                *--p = pair[1];
+                *--p = pair[0];
+            }
+            if (un >= 10)
+            {
+                char const* pair = pairs + 2 * unsigned(un);
+                *--p = pair[1];
+                *--p = pair[0];
+            }
+            else
+            {
+                *--p = char('0' + un);
+            }
+
+            detail::output_range(sink, p, end);
+            return true;
+        }
+
+        template <typename OutputIterator, typename T>
+        static bool
+        call(OutputIterator& sink, T n, T& num, int exp, mpl::false_)
         {
             // remainder_type::call returns n % Radix
             int ch = radix_type::digit(remainder_type::call(n));
@@ -481,7 +551,7 @@ namespace boost { namespace spirit { namespace karma
                 BOOST_KARMA_NUMERICS_INNER_LOOP_PREFIX, _);
 
             if (!detail::is_zero(n)) 
-                call(sink, n, num, exp);
+                call(sink, n, num, exp, mpl::false_());
 
             BOOST_PP_REPEAT(
                 BOOST_KARMA_NUMERICS_LOOP_UNROLL,
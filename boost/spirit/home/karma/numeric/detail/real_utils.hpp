@@ -22,6 +22,9 @@
 #include <boost/spirit/home/karma/detail/generate_to.hpp>
 #include <boost/spirit/home/karma/detail/string_generate.hpp>
 #include <boost/spirit/home/karma/numeric/detail/numeric_utils.hpp>
+#include <boost/spirit/home/karma/numeric/detail/shortest_real.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/mpl/bool.hpp>
 
 namespace boost { namespace spirit { namespace karma 
 { 
@@ -110,6 +113,15 @@ namespace boost { namespace spirit { namespace karma
         template <typename OutputIterator, typename U>
         static bool
         call_n (OutputIterator& sink, U n, Policies const& p)
+        {
+            return call_n(sink, n, p, mpl::bool_<
+                detail::is_shortest_policy<Policies>::value &&
+                detail::is_shortest_real<U>::value>());
+        }
+
+        template <typename OutputIterator, typename U>
+        static bool
+        call_n (OutputIterator& sink, U n, Policies const& p, mpl::false_)
         {
         // prepare sign and get output format
             bool force_sign = p.force_sign(n);
@@ -216,6 +228,98 @@ namespace boost { namespace spirit { namespace karma
             return r;
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        //  Generate the shortest digits converting back to the same number
+        //  (for float and double, see real_policies::shortest). Numbers 
+        //  needing more fractional digits than precision() are rounded as
+        //  above instead.
+        ///////////////////////////////////////////////////////////////////////
+        template <typename OutputIterator, typename U>
+        static bool
+        call_n (OutputIterator& sink, U n, Policies const& p, mpl::true_)
+        {
+        // prepare sign and get output format
+            bool force_sign = p.force_sign(n);
+            bool sign_val = false;
+            int flags = p.floatfield(n);
+            U abs_n = n;
+            if (detail::is_negative(n)) 
+            {
+                abs_n = -n;
+                sign_val = true;
+            }
+
+        // the significand and exponent of the shortest representation
+            boost::uint64_t digits = 0;
+            int exp = 0;
+            detail::shortest_digits(abs_n, digits, exp);
+
+            unsigned ndigits = detail::count_digits(digits);
+            unsigned precision = p.precision(n);
+
+        // split the digits into integer and fractional part
+            long dim = 0;
+            unsigned prec = 0;
+            U int_part = 0;
+            boost::uint64_t frac_part = 0;
+
+            if (0 == (Policies::fmtflags::fixed & flags))
+            {
+                dim = long(ndigits) - 1 + exp;
+                prec = ndigits - 1;
+            }
+            else if (exp < 0)
+            {
+                prec = unsigned(-exp);
+            }
+            else 
+            {
+                int_part = abs_n;       // an integer
+            }
+
+            if (prec > precision)
+                return call_n(sink, n, p, mpl::false_());
+
+            if (prec >= ndigits)
+            {
+                frac_part = digits;
+            }
+            else if (prec != 0)
+            {
+                boost::uint64_t scale = detail::pow10_u64(prec);
+                int_part = U(digits / scale);
+                frac_part = digits % scale;
+            }
+            else if (0 == (Policies::fmtflags::fixed & flags))
+            {
+                int_part = U(digits);
+            }
+
+        // add the trailing zeros if these are requested, as far as they fit
+            unsigned zeros = 0;
+            if (p.trailing_zeros(n) && prec < precision)
+            {
+                zeros = precision - prec;
+                for (/**/; zeros != 0 && prec < 19; --zeros, ++prec)
+                    frac_part *= 10;
+            }
+
+            if (0 == digits)
+                sign_val = false;     // result is zero, no sign please
+
+        // call the actual generating functions to output the different parts
+            bool r = p.integer_part(sink, int_part, sign_val, force_sign) &&
+                     p.dot(sink, U(frac_part), precision) &&
+                     p.fraction_part(sink, frac_part, prec, precision);
+
+            for (/**/; r && zeros != 0; --zeros)
+                r = char_inserter<>::call(sink, '0');
+
+            if (r && 0 == (Policies::fmtflags::fixed & flags))
+                return p.template exponent<CharEncoding, Tag>(sink, dim);
+            return r;
+        }
+
 #if BOOST_WORKAROUND(BOOST_MSVC, >= 1400)
 # pragma warning(pop)
 #endif 
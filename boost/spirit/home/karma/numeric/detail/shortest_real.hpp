@@ -0,0 +1,275 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(BOOST_SPIRIT_KARMA_SHORTEST_REAL_OCT_16_2026_0500PM)
+#define BOOST_SPIRIT_KARMA_SHORTEST_REAL_OCT_16_2026_0500PM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <cstring>
+#include <boost/cstdint.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/spirit/home/karma/numeric/detail/power_of_ten.hpp>
+
+namespace boost { namespace spirit { namespace karma { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  The IEEE 754 binary formats supported by the shortest representation
+    //  (see real_policies::shortest)
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    struct shortest_real_traits;
+
+    template <>
+    struct shortest_real_traits<double>
+    {
+        typedef boost::uint64_t bits_type;
+
+        static int const mantissa_bits = 52;
+        static int const exponent_mask = 0x7ff;
+        static int const minimum_exponent = -1074;
+    };
+
+    template <>
+    struct shortest_real_traits<float>
+    {
+        typedef boost::uint32_t bits_type;
+
+        static int const mantissa_bits = 23;
+        static int const exponent_mask = 0xff;
+        static int const minimum_exponent = -149;
+    };
+
+    template <typename T>
+    struct is_shortest_real : mpl::false_ {};
+
+    template <>
+    struct is_shortest_real<double> : mpl::true_ {};
+
+    template <>
+    struct is_shortest_real<float> : mpl::true_ {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  The shortest flag is optional for real number formatting policies, it
+    //  defaults to false if not defined
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Policies>
+    struct has_shortest
+    {
+        template <bool> struct check;
+        template <typename U>
+        static char test(check<U::shortest>*);
+        template <typename U>
+        static char (&test(...))[2];
+
+        static bool const value = sizeof(test<Policies>(0)) == 1;
+    };
+
+    template <typename Policies, bool HasFlag = has_shortest<Policies>::value>
+    struct is_shortest_policy : mpl::false_ {};
+
+    template <typename Policies>
+    struct is_shortest_policy<Policies, true>
+      : mpl::bool_<Policies::shortest> {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  Helper functions for the Schubfach algorithm
+    ///////////////////////////////////////////////////////////////////////////
+
+    // the high 64 bits of the product of a and b
+    inline boost::uint64_t multiply_high(boost::uint64_t a, boost::uint64_t b)
+    {
+#if defined(__GNUC__) && defined(__SIZEOF_INT128__)
+        return boost::uint64_t(((unsigned __int128)a * b) >> 64);
+#else
+        boost::uint64_t const mask = 0xffffffffULL;
+        boost::uint64_t const a_lo = a & mask, a_hi = a >> 32;
+        boost::uint64_t const b_lo = b & mask, b_hi = b >> 32;
+
+        boost::uint64_t const lo_lo = a_lo * b_lo;
+        boost::uint64_t const hi_lo = a_hi * b_lo;
+        boost::uint64_t const lo_hi = a_lo * b_hi;
+
+        boost::uint64_t const cross = (lo_lo >> 32) + (hi_lo & mask) + lo_hi;
+        return (hi_lo >> 32) + (cross >> 32) + a_hi * b_hi;
+#endif
+    }
+
+    // floor(e * log10(2))
+    inline int floor_log10_pow2(int e)
+    {
+        return int((boost::int64_t(e) * 661971961083LL) >> 41);
+    }
+
+    // floor(e * log10(2) + log10(3/4))
+    inline int floor_log10_three_quarters_pow2(int e)
+    {
+        return int((boost::int64_t(e) * 661971961083LL - 274743187321LL) >> 41);
+    }
+
+    // floor(e * log2(10))
+    inline int floor_log2_pow10(int e)
+    {
+        return int((boost::int64_t(e) * 913124641741LL) >> 38);
+    }
+
+    // (g * cp) >> 127, rounded to odd
+    inline boost::uint64_t
+    round_to_odd(boost::uint64_t const* g, boost::uint64_t cp)
+    {
+        boost::uint64_t const mask = ~boost::uint64_t(0) >> 1;
+
+        boost::uint64_t const x1 = multiply_high(g[1], cp);
+        boost::uint64_t const y0 = g[0] * cp;
+        boost::uint64_t const y1 = multiply_high(g[0], cp);
+        boost::uint64_t const z = (y0 >> 1) + x1;
+        boost::uint64_t const vbp = y1 + (z >> 63);
+        return vbp | (((z & mask) + mask) >> 63);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  Computes the shortest decimal f * 10^e rounding back to c * 2^q,
+    //  choosing the one closest to c * 2^q if there are several (see
+    //  Giulietti, "The Schubfach way to render doubles"). The significand f
+    //  may have trailing zeros.
+    ///////////////////////////////////////////////////////////////////////////
+    inline void
+    schubfach(int q, boost::uint64_t c, bool irregular
+      , boost::uint64_t& f, int& e)
+    {
+        boost::uint64_t const out = c & 1;
+        boost::uint64_t const cb = c << 2;
+        boost::uint64_t const cbr = cb + 2;
+        boost::uint64_t cbl;
+        int k;
+        if (!irregular)
+        {
+            cbl = cb - 2;
+            k = floor_log10_pow2(q);
+        }
+        else
+        {
+            // the lower neighbour is closer at a power of two
+            cbl = cb - 1;
+            k = floor_log10_three_quarters_pow2(q);
+        }
+
+        int const h = q + floor_log2_pow10(-k) + 2;
+        boost::uint64_t const* const g = power_of_ten_126(k);
+        boost::uint64_t const vb = round_to_odd(g, cb << h);
+        boost::uint64_t const vbl = round_to_odd(g, cbl << h);
+        boost::uint64_t const vbr = round_to_odd(g, cbr << h);
+
+        boost::uint64_t const s = vb >> 2;
+        if (s >= 10)
+        {
+            // try one digit less first
+            boost::uint64_t const sp10 = s / 10 * 10;
+            boost::uint64_t const tp10 = sp10 + 10;
+            bool const upin = vbl + out <= (sp10 << 2);
+            bool const wpin = (tp10 << 2) + out <= vbr;
+            if (upin != wpin)
+            {
+                f = upin ? sp10 : tp10;
+                e = k;
+                return;
+            }
+        }
+
+        boost::uint64_t const t = s + 1;
+        bool const uin = vbl + out <= (s << 2);
+        bool const win = (t << 2) + out <= vbr;
+        if (uin != win)
+        {
+            f = uin ? s : t;
+            e = k;
+            return;
+        }
+
+        // both are in the rounding interval, take the closer one
+        boost::uint64_t const mid = (s + t) << 1;
+        f = (vb < mid || (vb == mid && (s & 1) == 0)) ? s : t;
+        e = k;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  Converts the positive, finite n into the shortest decimal significand
+    //  and exponent (n ~ significand * 10^exponent) which converts back to n.
+    //  The significand has no trailing zeros (zero is returned as 0 * 10^0).
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    inline void
+    shortest_digits(T n, boost::uint64_t& significand, int& exponent)
+    {
+        typedef shortest_real_traits<T> traits;
+        typedef typename traits::bits_type bits_type;
+
+        bits_type bits;
+        std::memcpy(&bits, &n, sizeof(T));
+
+        boost::uint64_t const hidden_bit =
+            boost::uint64_t(1) << traits::mantissa_bits;
+        boost::uint64_t const fraction = bits & (hidden_bit - 1);
+        int const biased =
+            int(bits >> traits::mantissa_bits) & traits::exponent_mask;
+
+        if (biased != 0)
+        {
+            int const q = traits::minimum_exponent - 1 + biased;
+            boost::uint64_t const c = hidden_bit | fraction;
+
+            // small integers are their own shortest representation
+            if (q < 0 && q > -traits::mantissa_bits - 1 &&
+                ((c >> -q) << -q) == c)
+            {
+                significand = c >> -q;
+                exponent = 0;
+            }
+            else
+            {
+                bool const irregular = c == hidden_bit && biased != 1;
+                schubfach(q, c, irregular, significand, exponent);
+            }
+        }
+        else if (fraction == 0)
+        {
+            significand = 0;
+            exponent = 0;
+            return;
+        }
+        else
+        {
+            schubfach(traits::minimum_exponent, fraction, false
+              , significand, exponent);
+        }
+
+        while (significand % 10 == 0)
+        {
+            significand /= 10;
+            ++exponent;
+        }
+    }
+
+    // the number of decimal digits in n (one for zero)
+    inline unsigned count_digits(boost::uint64_t n)
+    {
+        unsigned digits = 1;
+        for (/**/; n >= 10; n /= 10)
+            ++digits;
+        return digits;
+    }
+
+    inline boost::uint64_t pow10_u64(unsigned exp)
+    {
+        boost::uint64_t result = 1;
+        while (exp-- != 0)
+            result *= 10;
+        return result;
+    }
+}}}}
+
+#endif
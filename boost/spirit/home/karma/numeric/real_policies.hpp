@@ -73,6 +73,16 @@ namespace boost { namespace spirit { namespace karma
             };
         };
 
+        ///////////////////////////////////////////////////////////////////////
+        //  If set, float and double numbers are generated using the shortest
+        //  digit sequence which converts back to the same number (e.g. 0.3
+        //  instead of 0.29999999999999999), as long as these fit into the 
+        //  number of fractional digits returned by precision(). Numbers 
+        //  needing more digits are rounded as usual. The fractional part is
+        //  passed to fraction_part() as a boost::uint64_t in this case.
+        ///////////////////////////////////////////////////////////////////////
+        static bool const shortest = false;
+
         ///////////////////////////////////////////////////////////////////////
         //  This is the main function used to generate the output for a 
         //  floating point number. It is called by the real generator in order 
@@ -266,6 +276,24 @@ namespace boost { namespace spirit { namespace karma
             return r;
         }
 
+        // The same for the integral fractional part as generated if the
+        // shortest representation is requested.
+        template <typename OutputIterator, typename Integer>
+        static bool fraction_part (OutputIterator& sink, Integer n
+          , unsigned precision_, unsigned precision)
+        {
+            unsigned digits = 1;
+            for (Integer m = n / 10; m != 0; m /= 10)
+                ++digits;
+
+            bool r = true;
+            for (/**/; r && digits < precision_; ++digits)
+                r = char_inserter<>::call(sink, '0');
+            if (precision && r)
+                r = int_inserter<10>::call(sink, n);
+            return r;
+        }
+
         ///////////////////////////////////////////////////////////////////////
         //  Generate the exponential part of the number (this is called only 
         //  if the floatfield() function returned the 'scientific' flag).
@@ -0,0 +1,49 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(BOOST_SPIRIT_LEX_BASE_ITERATOR_OCT_16_2026_0500PM)
+#define BOOST_SPIRIT_LEX_BASE_ITERATOR_OCT_16_2026_0500PM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/detail/iterator.hpp>
+#include <boost/mpl/eval_if.hpp>
+#include <boost/mpl/has_xxx.hpp>
+
+namespace boost { namespace spirit { namespace lex { namespace detail
+{
+    BOOST_MPL_HAS_XXX_TRAIT_DEF(base_iterator_type)
+
+    template <typename Iterator>
+    struct lexer_base_iterator
+    {
+        typedef typename Iterator::base_iterator_type type;
+    };
+
+    template <typename Iterator>
+    struct token_base_iterator
+    {
+        typedef typename
+            boost::detail::iterator_traits<Iterator>::value_type
+        token_type;
+        typedef typename token_type::iterator_type type;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  Return the type of the iterator of the underlying character stream for
+    //  a given token iterator. This is the base_iterator_type exposed by the
+    //  token iterators of the lexers, or the iterator_type of the token for
+    //  plain iterators over stored tokens (as filled by tokenize_all()).
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Iterator>
+    struct base_iterator
+      : mpl::eval_if<has_base_iterator_type<Iterator>
+          , lexer_base_iterator<Iterator>, token_base_iterator<Iterator> >
+    {};
+}}}}
+
+#endif
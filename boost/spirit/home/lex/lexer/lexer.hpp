@@ -18,6 +18,7 @@
 #include <boost/spirit/home/lex/meta_compiler.hpp>
 #include <boost/spirit/home/lex/lexer_type.hpp>
 #include <boost/spirit/home/lex/lexer/token_def.hpp>
+#include <boost/spirit/home/lex/detail/base_iterator.hpp>
 #include <boost/assert.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/detail/iterator.hpp>
@@ -66,7 +67,8 @@ namespace boost { namespace spirit { namespace lex
             {
                 //  the return value of a token set contains the matched token 
                 //  id, and the corresponding pair of iterators
-                typedef typename Iterator::base_iterator_type iterator_type;
+                typedef typename lex::detail::base_iterator<Iterator>::type
+                    iterator_type;
                 typedef 
                     fusion::vector2<id_type, iterator_range<iterator_type> > 
                 type;
@@ -317,7 +319,9 @@ namespace boost { namespace spirit { namespace lex
         {
             match_default = 0,          // no flags
             match_not_dot_newline = 1,  // the regex '.' doesn't match newlines
-            match_icase = 2             // all matching operations are case insensitive
+            match_icase = 2,            // all matching operations are case insensitive
+            match_compress_dfa = 4,     // use narrow, row-deduplicated DFA tables
+            match_parallel_dfa = 8      // build the DFA using all processors
         };
     };
 
@@ -0,0 +1,253 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(BOOST_SPIRIT_LEX_COMPACT_TOKEN_OCT_16_2026_0300PM)
+#define BOOST_SPIRIT_LEX_COMPACT_TOKEN_OCT_16_2026_0300PM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/config.hpp>
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/detail/iterator.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/spirit/home/lex/lexer/lexertl/token.hpp>
+
+#if defined(BOOST_SPIRIT_DEBUG)
+#include <iosfwd>
+#endif
+
+namespace boost { namespace spirit { namespace lex { namespace lexertl
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //
+    //  The compact_token is a token type for lexers which don't need token
+    //  values other than the matched input sequence (i.e. all token_def's
+    //  expose the matched iterator range, or convert it each time their
+    //  attribute is requested). Instead of a pair of iterators it stores the
+    //  start of the matched sequence and its length, and the lexer state is
+    //  kept in 32 bits next to it. Compared to token<Iterator> this saves
+    //  8 bytes per token on 64 bit systems (24 instead of 32 bytes for a
+    //  pointer iterator), which directly reduces the memory used to buffer
+    //  tokens for backtracking.
+    //
+    //    template parameters:
+    //        Iterator        The type of the iterator used to access the
+    //                        underlying character stream, this needs to be
+    //                        a random access iterator.
+    //        HasState        A mpl::bool_ indicating, whether this token type
+    //                        should support lexer states.
+    //        Idtype          The type to use for the token id (defaults to
+    //                        std::size_t).
+    //
+    //  Note: matched sequences need to be shorter than 2^32 characters. The
+    //        token value is the iterator range of the matched sequence, which
+    //        is returned by value from value().
+    //
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Iterator = char const*
+      , typename HasState = mpl::true_
+      , typename Idtype = std::size_t>
+    struct compact_token : token<Iterator, lex::omit, mpl::false_, Idtype>
+    {
+    private: // precondition assertions
+        BOOST_STATIC_ASSERT((is_convertible<
+            typename boost::detail::iterator_traits<Iterator>::iterator_category
+          , std::random_access_iterator_tag>::value));
+
+        typedef token<Iterator, lex::omit, mpl::false_, Idtype> base_type;
+        typedef boost::uint32_t size_type;
+
+        static size_type const npos_state = size_type(~0);
+
+    public:
+        typedef typename base_type::id_type id_type;
+        typedef Iterator iterator_type;
+        typedef HasState has_state;
+        typedef iterator_range<Iterator> token_value_type;
+
+        //  default constructed tokens correspond to EOI tokens
+        compact_token()
+          : state_(npos_state), length_(0), first_() {}
+
+        //  construct an invalid token
+        explicit compact_token(int)
+          : base_type(0), state_(npos_state), length_(0), first_() {}
+
+        compact_token(id_type id, std::size_t state
+              , token_value_type const& value)
+          : base_type(id, boost::lexer::npos, value.begin(), value.end())
+          , state_(compact_state(state))
+          , length_(compact_length(value.begin(), value.end()))
+          , first_(value.begin()) {}
+
+        compact_token(id_type id, std::size_t state, Iterator const& first
+              , Iterator const& last)
+          : base_type(id, boost::lexer::npos, first, last)
+          , state_(compact_state(state))
+          , length_(compact_length(first, last))
+          , first_(first) {}
+
+        std::size_t state() const
+        {
+            if (!HasState::value)
+                return 0;     // always '0' (INITIAL state)
+            return npos_state == state_ ? boost::lexer::npos : state_;
+        }
+
+        token_value_type value() const
+        {
+            return token_value_type(first_, first_ + length_);
+        }
+
+    private:
+        static size_type compact_state(std::size_t state)
+        {
+            BOOST_ASSERT(boost::lexer::npos == state || state < npos_state);
+            return boost::lexer::npos == state ? npos_state : size_type(state);
+        }
+
+        static size_type compact_length(Iterator const& first
+          , Iterator const& last)
+        {
+            // If the following assertion fires the matched input sequence
+            // is too long to be stored in a compact_token. Use the token<>
+            // type instead.
+            BOOST_ASSERT(std::size_t(last - first) < std::size_t(~size_type(0)));
+            return size_type(last - first);
+        }
+
+    protected:
+        size_type state_;       // lexer state this token was matched in
+        size_type length_;      // length of the matched input sequence
+        Iterator first_;        // start of the matched input sequence
+    };
+
+#if defined(BOOST_SPIRIT_DEBUG)
+    template <typename Char, typename Traits, typename Iterator
+      , typename HasState, typename Idtype>
+    inline std::basic_ostream<Char, Traits>&
+    operator<< (std::basic_ostream<Char, Traits>& os
+      , compact_token<Iterator, HasState, Idtype> const& t)
+    {
+        if (t.is_valid()) {
+            Iterator end = t.matched_.second;
+            for (Iterator it = t.matched_.first; it != end; ++it)
+                os << *it;
+        }
+        else {
+            os << "<invalid token>";
+        }
+        return os;
+    }
+#endif
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  tokens are considered equal, if their id's match (these are unique)
+    template <typename Iterator, typename HasState, typename Idtype>
+    inline bool
+    operator== (compact_token<Iterator, HasState, Idtype> const& lhs,
+                compact_token<Iterator, HasState, Idtype> const& rhs)
+    {
+        return lhs.id() == rhs.id();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  This overload is needed by the multi_pass/functor_input_policy to
+    //  validate a token instance. It has to be defined in the same namespace
+    //  as the token class itself to allow ADL to find it.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Iterator, typename HasState, typename Idtype>
+    inline bool
+    token_is_valid(compact_token<Iterator, HasState, Idtype> const& t)
+    {
+        return t.is_valid();
+    }
+}}}}
+
+namespace boost { namespace spirit { namespace traits
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  The compact_token carries the matched input sequence only, which is
+    //  converted to the requested attribute type on every access.
+    template <typename Attribute, typename Iterator, typename HasState
+      , typename Idtype>
+    struct assign_to_attribute_from_value<Attribute
+      , lex::lexertl::compact_token<Iterator, HasState, Idtype> >
+    {
+        static void
+        call(lex::lexertl::compact_token<Iterator, HasState, Idtype> const& t
+          , Attribute& attr)
+        {
+            iterator_range<Iterator> const ip = t.value();
+            spirit::traits::assign_to(ip.begin(), ip.end(), attr);
+        }
+    };
+
+    template <typename Attribute, typename Iterator, typename HasState
+      , typename Idtype>
+    struct assign_to_container_from_value<Attribute
+          , lex::lexertl::compact_token<Iterator, HasState, Idtype> >
+      : assign_to_attribute_from_value<Attribute
+          , lex::lexertl::compact_token<Iterator, HasState, Idtype> >
+    {};
+
+    //  This is called from the parse function of lexer_def_
+    template <typename Iterator, typename HasState, typename Idtype_
+      , typename Idtype>
+    struct assign_to_attribute_from_value<
+        fusion::vector2<Idtype_, iterator_range<Iterator> >
+      , lex::lexertl::compact_token<Iterator, HasState, Idtype> >
+    {
+        static void
+        call(lex::lexertl::compact_token<Iterator, HasState, Idtype> const& t
+          , fusion::vector2<Idtype_, iterator_range<Iterator> >& attr)
+        {
+            //  The type returned by the lexer_def_ parser components is a
+            //  fusion::vector containing the token id of the matched token
+            //  and the pair of iterators to the matched character sequence.
+            typedef fusion::vector2<Idtype_, iterator_range<Iterator> >
+                attribute_type;
+
+            attr = attribute_type(t.id(), t.value());
+        }
+    };
+
+    template <typename Iterator, typename HasState, typename Idtype_
+      , typename Idtype>
+    struct assign_to_container_from_value<
+            fusion::vector2<Idtype_, iterator_range<Iterator> >
+          , lex::lexertl::compact_token<Iterator, HasState, Idtype> >
+      : assign_to_attribute_from_value<
+            fusion::vector2<Idtype_, iterator_range<Iterator> >
+          , lex::lexertl::compact_token<Iterator, HasState, Idtype> >
+    {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Overload debug output for a single token, this integrates lexer tokens
+    // with Qi's simple_trace debug facilities
+    template <typename Iterator, typename HasState, typename Idtype>
+    struct token_printer_debug<
+        lex::lexertl::compact_token<Iterator, HasState, Idtype> >
+    {
+        typedef lex::lexertl::compact_token<Iterator, HasState, Idtype>
+            token_type;
+
+        template <typename Out>
+        static void print(Out& out, token_type const& val)
+        {
+            out << '[';
+            spirit::traits::print_token(out, val.value());
+            out << ']';
+        }
+    };
+}}}
+
+#endif
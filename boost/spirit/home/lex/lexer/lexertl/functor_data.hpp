@@ -25,7 +25,7 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
         ///////////////////////////////////////////////////////////////////////
         template <typename Iterator, typename HasActors, typename HasState
           , typename TokenValue>
-        class data;    // no default specialization
+        class data;    // supports actors, defined below
 
         ///////////////////////////////////////////////////////////////////////
         //  neither supports state, nor actors
@@ -267,13 +267,16 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
         };
 
         ///////////////////////////////////////////////////////////////////////
-        //  does support lexer semantic actions, may support state
-        template <typename Iterator, typename HasState, typename TokenValue>
-        class data<Iterator, mpl::true_, HasState, TokenValue> 
+        //  does support lexer semantic actions, may support state (HasActors
+        //  is either mpl::true_ or typed_actions<>)
+        template <typename Iterator, typename HasActors, typename HasState
+          , typename TokenValue>
+        class data
           : public data<Iterator, mpl::false_, HasState, TokenValue>
         {
         public:
-            typedef semantic_actions<Iterator, HasState, data> 
+            typedef typename select_semantic_actions<HasActors, Iterator, HasState
+              , data>::type 
                 semantic_actions_type;
 
         protected:
@@ -815,6 +815,356 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
         return os_.good();
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // generate the code recording the DFA state 'ptr_' as the last end state
+    // seen
+    inline void generate_goto_end_state(std::ostream & os_
+      , std::size_t const* ptr_, char const* indent_, bool multiple_dfas
+      , bool bol)
+    {
+        os_ << indent_ << "end_state_ = true;\n";
+        os_ << indent_ << "id_ = " << ptr_[boost::lexer::id_index] << ";\n";
+        os_ << indent_ << "uid_ = " << ptr_[boost::lexer::unique_id_index]
+            << ";\n";
+        os_ << indent_ << "end_token_ = curr_;\n";
+        if (multiple_dfas)
+        {
+            os_ << indent_ << "end_start_state_ = "
+                << ptr_[boost::lexer::state_index] << ";\n";
+        }
+        if (bol)
+        {
+            os_ << indent_ << "end_bol_ = bol;\n";
+        }
+    }
+
+    // emit the name of the label representing the given DFA state, the jam
+    // state (0) is represented by the label 'end'
+    inline void generate_goto_label(std::ostream & os_, std::size_t dfa_
+      , std::size_t state_)
+    {
+        if (state_ == 0)
+            os_ << "end";
+        else
+            os_ << "state" << dfa_ << '_' << state_;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // generate function body based on directly threaded code: every DFA
+    // state is a label and every transition is a jump through a per DFA table
+    // of label addresses (GCC and clang), or through a per state switch on
+    // the character class (all other compilers)
+    template <typename Char>
+    bool generate_function_body_goto(std::ostream & os_
+      , boost::lexer::basic_state_machine<Char> const &sm_)
+    {
+        std::size_t const dfas_ = sm_.data()._dfa->size();
+        std::size_t const lookups_ = sm_.data()._lookup->front()->size();
+        bool const bol_ = sm_.data()._seen_BOL_assertion;
+
+        os_ << "#if !defined(BOOST_SPIRIT_LEXERTL_NO_COMPUTED_GOTO) && "
+               "defined(__GNUC__)\n";
+        os_ << "#if !defined(BOOST_SPIRIT_LEXERTL_COMPUTED_GOTO)\n";
+        os_ << "#define BOOST_SPIRIT_LEXERTL_COMPUTED_GOTO\n";
+        os_ << "#define BOOST_SPIRIT_LEXERTL_UNDEF_COMPUTED_GOTO\n";
+        os_ << "#endif\n";
+        os_ << "#endif\n\n";
+
+        os_ << "    static std::size_t const npos = "
+               "static_cast<std::size_t>(~0);\n\n";
+
+        // The character classes (columns of the DFA) are renumbered such that
+        // the dead column is 0, which makes every jump table start with the
+        // label 'end'.
+        for (std::size_t dfa_ = 0; dfa_ < dfas_; ++dfa_)
+        {
+            std::size_t const* lookup_ = &sm_.data()._lookup[dfa_]->front();
+            std::size_t const alphabet_ = sm_.data()._dfa_alphabet[dfa_];
+            std::size_t const columns_ =
+                alphabet_ - boost::lexer::dfa_offset + 1;
+
+            os_ << "    static unsigned "
+                << (columns_ <= 0xff ? "char" :
+                    (columns_ <= 0xffff ? "short" : "int"))
+                << " const lookup" << dfa_ << "_[" << lookups_ << "] = {";
+            for (std::size_t i_ = 0; i_ < lookups_; ++i_)
+            {
+                std::size_t const col_ = lookup_[i_];
+
+                os_ << (i_ ? "," : "") << ((i_ % 16) ? " " : "\n        ")
+                    << (col_ == boost::lexer::dead_state_index ? 0 :
+                        col_ - boost::lexer::dfa_offset + 1);
+            }
+            os_ << " };\n";
+        }
+
+        os_ << "\n#if defined(BOOST_SPIRIT_LEXERTL_COMPUTED_GOTO)\n";
+        for (std::size_t dfa_ = 0; dfa_ < dfas_; ++dfa_)
+        {
+            std::size_t const* table_ = &sm_.data()._dfa[dfa_]->front();
+            std::size_t const alphabet_ = sm_.data()._dfa_alphabet[dfa_];
+            std::size_t const states_ =
+                sm_.data()._dfa[dfa_]->size() / alphabet_;
+            std::size_t const columns_ =
+                alphabet_ - boost::lexer::dfa_offset + 1;
+
+            os_ << "    static void* const jump" << dfa_ << "_["
+                << (states_ - 1) * columns_ << "] = {";
+            for (std::size_t state_ = 1; state_ < states_; ++state_)
+            {
+                std::size_t const* ptr_ = table_ + state_ * alphabet_;
+
+                os_ << (state_ > 1 ? ",\n        " : "\n        ") << "&&end";
+                for (std::size_t col_ = boost::lexer::dfa_offset;
+                     col_ < alphabet_; ++col_)
+                {
+                    os_ << ", &&";
+                    generate_goto_label(os_, dfa_, ptr_[col_]);
+                }
+            }
+            os_ << " };\n";
+        }
+        os_ << "#endif\n";
+
+        os_ << "\n    if (start_token_ == end_)\n";
+        os_ << "    {\n";
+        os_ << "        unique_id_ = npos;\n";
+        os_ << "        return 0;\n";
+        os_ << "    }\n\n";
+
+        if (bol_)
+        {
+            os_ << "    bool bol = bol_;\n";
+        }
+
+        if (dfas_ > 1)
+        {
+            os_ << "again:\n";
+        }
+
+        os_ << "    Iterator curr_ = start_token_;\n";
+        os_ << "    bool end_state_ = false;\n";
+        os_ << "    std::size_t id_ = npos;\n";
+        os_ << "    std::size_t uid_ = npos;\n";
+
+        if (dfas_ > 1)
+        {
+            os_ << "    std::size_t end_start_state_ = start_state_;\n";
+        }
+
+        if (bol_)
+        {
+            os_ << "    bool end_bol_ = bol_;\n";
+        }
+
+        os_ << "    Iterator end_token_ = start_token_;\n";
+        os_ << "    " << ((lookups_ == 256) ? "unsigned char" : "std::size_t")
+            << " ch_ = 0;\n\n";
+
+        if (dfas_ > 1)
+        {
+            os_ << "    switch (start_state_)\n";
+            os_ << "    {\n";
+
+            for (std::size_t i_ = 0; i_ < dfas_; ++i_)
+            {
+                os_ << "    case " << i_ << ":\n";
+                os_ << "        goto state" << i_ << "_1;\n";
+            }
+
+            os_ << "    default:\n";
+            os_ << "        goto end;\n";
+            os_ << "    }\n";
+        }
+        else
+        {
+            os_ << "    goto state0_1;\n";
+        }
+
+        for (std::size_t dfa_ = 0; dfa_ < dfas_; ++dfa_)
+        {
+            std::size_t const* table_ = &sm_.data()._dfa[dfa_]->front();
+            std::size_t const alphabet_ = sm_.data()._dfa_alphabet[dfa_];
+            std::size_t const states_ =
+                sm_.data()._dfa[dfa_]->size() / alphabet_;
+            std::size_t const columns_ =
+                alphabet_ - boost::lexer::dfa_offset + 1;
+
+            for (std::size_t state_ = 1; state_ < states_; ++state_)
+            {
+                std::size_t const* ptr_ = table_ + state_ * alphabet_;
+                std::size_t const bol_state_ = ptr_[boost::lexer::bol_index];
+                std::size_t const eol_state_ = ptr_[boost::lexer::eol_index];
+                bool transitions_ = false;
+
+                for (std::size_t col_ = boost::lexer::dfa_offset;
+                     col_ < alphabet_ && !transitions_; ++col_)
+                {
+                    transitions_ = ptr_[col_] != 0;
+                }
+
+                os_ << "\nstate" << dfa_ << '_' << state_ << ":\n";
+
+                if (ptr_[boost::lexer::end_state_index])
+                {
+                    generate_goto_end_state(os_, ptr_, "    ", dfas_ > 1
+                      , bol_);
+                }
+
+                if (!transitions_ && !bol_state_ && !eol_state_)
+                {
+                    os_ << "    goto end;\n";
+                    continue;
+                }
+
+                if (eol_state_)
+                {
+                    // the end of the input matches '$' as well
+                    std::size_t const* eol_ptr_ =
+                        table_ + eol_state_ * alphabet_;
+
+                    os_ << "    if (curr_ == end_)\n";
+                    os_ << "    {\n";
+                    if (eol_ptr_[boost::lexer::end_state_index])
+                    {
+                        generate_goto_end_state(os_, eol_ptr_, "        "
+                          , dfas_ > 1, bol_);
+                    }
+                    os_ << "        goto end;\n";
+                    os_ << "    }\n";
+                }
+                else
+                {
+                    os_ << "    if (curr_ == end_) goto end;\n";
+                }
+
+                if (bol_state_)
+                {
+                    os_ << "    if (bol) goto state" << dfa_ << '_'
+                        << bol_state_ << ";\n";
+                }
+                if (eol_state_)
+                {
+                    os_ << "    if (*curr_ == '\\n') goto state" << dfa_
+                        << '_' << eol_state_ << ";\n";
+                }
+                if (!transitions_)
+                {
+                    os_ << "    goto end;\n";
+                    continue;
+                }
+
+                if (lookups_ == 256)
+                {
+                    os_ << "    ch_ = static_cast<unsigned char>(*curr_++);\n";
+                }
+                else
+                {
+                    os_ << "    ch_ = static_cast<std::size_t>(*curr_++);\n";
+                }
+                if (bol_)
+                {
+                    os_ << "    bol = (ch_ == '\\n') ? true : false;\n";
+                }
+
+                os_ << "#if defined(BOOST_SPIRIT_LEXERTL_COMPUTED_GOTO)\n";
+                os_ << "    goto *jump" << dfa_ << "_[";
+                if (state_ > 1)
+                {
+                    os_ << (state_ - 1) * columns_ << " + ";
+                }
+                os_ << "lookup" << dfa_ << "_[ch_]];\n";
+                os_ << "#else\n";
+                os_ << "    switch (lookup" << dfa_ << "_[ch_])\n";
+                os_ << "    {\n";
+
+                // group all character classes sharing the same target
+                std::vector<bool> done_(alphabet_, false);
+                for (std::size_t col_ = boost::lexer::dfa_offset;
+                     col_ < alphabet_; ++col_)
+                {
+                    std::size_t const target_ = ptr_[col_];
+
+                    if (target_ == 0 || done_[col_])
+                        continue;
+
+                    for (std::size_t other_ = col_; other_ < alphabet_;
+                         ++other_)
+                    {
+                        if (ptr_[other_] == target_)
+                        {
+                            done_[other_] = true;
+                            os_ << "    case "
+                                << other_ - boost::lexer::dfa_offset + 1
+                                << ":\n";
+                        }
+                    }
+                    os_ << "        goto state" << dfa_ << '_' << target_
+                        << ";\n";
+                }
+                os_ << "    default:\n";
+                os_ << "        goto end;\n";
+                os_ << "    }\n";
+                os_ << "#endif\n";
+            }
+        }
+
+        os_ << "\nend:\n";
+        os_ << "    if (end_state_)\n";
+        os_ << "    {\n";
+        os_ << "        // return longest match\n";
+        os_ << "        start_token_ = end_token_;\n";
+
+        if (dfas_ > 1)
+        {
+            os_ << "        start_state_ = end_start_state_;\n";
+            os_ << "\n        if (id_ == 0)\n";
+            os_ << "        {\n";
+
+            if (bol_)
+            {
+                os_ << "            bol = end_bol_;\n";
+            }
+
+            os_ << "            goto again;\n";
+            os_ << "        }\n";
+
+            if (bol_)
+            {
+                os_ << "        else\n";
+                os_ << "        {\n";
+                os_ << "            bol_ = end_bol_;\n";
+                os_ << "        }\n";
+            }
+        }
+        else if (bol_)
+        {
+            os_ << "        bol_ = end_bol_;\n";
+        }
+
+        os_ << "    }\n";
+        os_ << "    else\n";
+        os_ << "    {\n";
+
+        if (bol_)
+        {
+            os_ << "        bol_ = (*start_token_ == '\\n') ? true : false;\n";
+        }
+        os_ << "        id_ = npos;\n";
+        os_ << "        uid_ = npos;\n";
+        os_ << "    }\n\n";
+
+        os_ << "    unique_id_ = uid_;\n";
+        os_ << "    return id_;\n";
+
+        // don't leak the macro into the code including the generated file
+        os_ << "\n#if defined(BOOST_SPIRIT_LEXERTL_UNDEF_COMPUTED_GOTO)\n";
+        os_ << "#undef BOOST_SPIRIT_LEXERTL_COMPUTED_GOTO\n";
+        os_ << "#undef BOOST_SPIRIT_LEXERTL_UNDEF_COMPUTED_GOTO\n";
+        os_ << "#endif\n";
+        return os_.good();
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // Generate a tokenizer for the given state machine.
     template <typename Char, typename F>
@@ -919,6 +1269,12 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
     {
         if (!lexer.init_dfa(true))    // always minimize DFA for static lexers
             return false;
+
+        // a lexer using an adopted DFA image (see adopt_dfa_image) has the
+        // compressed tables only, the code generators need the full DFA
+        if (lexer.state_machine_.data()._dfa->empty())
+            return false;
+
         return detail::generate_cpp(lexer.state_machine_, lexer.rules_, os
           , name_suffix, f);
     }
@@ -955,6 +1311,19 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
           , &detail::generate_function_body_switch<typename Lexer::char_type>);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // The generated code uses computed goto's if compiled with gcc or clang,
+    // define BOOST_SPIRIT_LEXERTL_NO_COMPUTED_GOTO to fall back to a switch
+    // statement for each of the DFA states.
+    template <typename Lexer>
+    inline bool 
+    generate_static_goto(Lexer const& lexer, std::ostream& os
+      , char const* name_suffix = "")
+    {
+        return generate_static(lexer, os, name_suffix
+          , &detail::generate_function_body_goto<typename Lexer::char_type>);
+    }
+
 ///////////////////////////////////////////////////////////////////////////////
 }}}}
 
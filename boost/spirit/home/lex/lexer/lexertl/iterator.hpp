@@ -116,6 +116,79 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
         }
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        //  bulk_input stands in for the multi_pass iterator while tokenize_all
+        //  invokes the lexer functor directly. It exposes the same interface
+        //  as used by the functor (mp.shared()->ftor and mp.ftor).
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Functor>
+        struct bulk_input
+        {
+            typedef typename Functor::shared shared_functor_type;
+            typedef typename Functor::iterator_type base_iterator_type;
+
+            struct shared_data
+            {
+                template <typename IteratorData>
+                shared_data(IteratorData const& iterdata_
+                      , base_iterator_type& first
+                      , base_iterator_type const& last)
+                  : ftor(iterdata_, first, last) {}
+
+                shared_functor_type ftor;
+            };
+
+            template <typename IteratorData>
+            bulk_input(IteratorData const& iterdata_
+                  , base_iterator_type& first, base_iterator_type const& last)
+              : shared_(iterdata_, first, last) {}
+
+            shared_data* shared() const { return &shared_; }
+
+            Functor ftor;
+            mutable shared_data shared_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  tokenize_all runs the lexer over the whole input sequence at once,
+    //  appending all generated tokens to the given container (usually a
+    //  std::vector). It invokes the functor directly, bypassing the multi_pass
+    //  iterator, so there is no reference counting and no token buffering
+    //  involved. The tokens may then be handed to a parser using the plain
+    //  (random access) iterators of the container.
+    //
+    //  The function returns true if all of the input was matched. Otherwise
+    //  'first' points to the position where no token could be matched.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Functor, typename IteratorData, typename Container>
+    inline bool
+    tokenize_all(IteratorData const& iterdata_
+      , typename Functor::iterator_type& first
+      , typename Functor::iterator_type const& last, Container& tokens
+      , typename Functor::char_type const* state = 0)
+    {
+        typedef typename Functor::result_type token_type;
+
+        detail::bulk_input<Functor> input(iterdata_, first, last);
+        if (0 != state)
+            Functor::set_state(input, Functor::map_state(input, state));
+
+        token_type t;
+        for (;;)
+        {
+            Functor::get_next(input, t);
+            if (t == input.ftor.eof)
+                return true;
+            if (!token_is_valid(t))
+                return false;
+            tokens.push_back(t);
+        }
+    }
+
 }}}}
 
 #endif
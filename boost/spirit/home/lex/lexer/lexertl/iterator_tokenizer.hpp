@@ -11,10 +11,12 @@
 #endif
 
 #include <boost/detail/iterator.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/spirit/home/support/detail/lexer/state_machine.hpp>
 #include <boost/spirit/home/support/detail/lexer/consts.hpp>
 #include <boost/spirit/home/support/detail/lexer/size_t.hpp>
 #include <boost/spirit/home/support/detail/lexer/char_traits.hpp>
+#include <boost/spirit/home/lex/lexer/lexertl/skip_self_loop.hpp>
 #include <vector>
 
 namespace boost { namespace spirit { namespace lex { namespace lexertl
@@ -39,6 +41,12 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
                 return 0;
             }
 
+            if (!state_machine_.data()._compressed->empty())
+            {
+                return next_compressed(state_machine_.data(), dfa_state_
+                  , bol_, start_token_, end_, unique_id_, true);
+            }
+
             bool bol = bol_;
 
         again:
@@ -46,6 +54,8 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
                 front ();
             std::size_t dfa_alphabet_ = state_machine_.data()._dfa_alphabet[dfa_state_];
             std::size_t const* dfa_ = &state_machine_.data()._dfa[dfa_state_]->front ();
+            detail::self_loop const* loops_ = 
+                self_loops(state_machine_.data(), dfa_state_);
 
             std::size_t const* ptr_ = dfa_ + dfa_alphabet_;
             Iterator curr_ = start_token_;
@@ -90,6 +100,7 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
                     }
 
                     ptr_ = &dfa_[state_ * dfa_alphabet_];
+                    detail::skip_self_loop(loops_, state_, curr_, end_, bol);
                 }
 
                 if (*ptr_)
@@ -157,10 +168,19 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
                 return 0;
             }
 
+            if (!state_machine_.data()._compressed->empty())
+            {
+                std::size_t dfa_state = 0;
+                return next_compressed(state_machine_.data(), dfa_state
+                  , bol_, start_token_, end_, unique_id_, false);
+            }
+
             bool bol = bol_;
             std::size_t const* lookup_ = &state_machine_.data()._lookup[0]->front();
             std::size_t dfa_alphabet_ = state_machine_.data()._dfa_alphabet[0];
             std::size_t const* dfa_ = &state_machine_.data()._dfa[0]->front ();
+            detail::self_loop const* loops_ = 
+                self_loops(state_machine_.data(), 0);
             std::size_t const* ptr_ = dfa_ + dfa_alphabet_;
 
             Iterator curr_ = start_token_;
@@ -204,6 +224,7 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
                     }
 
                     ptr_ = &dfa_[state_ * dfa_alphabet_];
+                    detail::skip_self_loop(loops_, state_, curr_, end_, bol);
                 }
 
                 if (*ptr_)
@@ -243,6 +264,168 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
                 uid_ = boost::lexer::npos;
             }
 
+            unique_id_ = uid_;
+            return id_;
+        }
+
+    private:
+        ///////////////////////////////////////////////////////////////////////
+        //  Return the self loops of the DFA states of the given lexer state,
+        //  if any.
+        static detail::self_loop const* self_loops(
+            boost::lexer::detail::internals const& internals_
+          , std::size_t dfa_state_)
+        {
+            if (internals_._self_loops->empty() || 
+                internals_._self_loops[dfa_state_]->empty())
+            {
+                return 0;
+            }
+            return &internals_._self_loops[dfa_state_]->front();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        //  Dispatch to the tokeniser matching the cell width of the tables 
+        //  built by boost::lexer::basic_generator::compress(). All lexer 
+        //  states share the same width.
+        static std::size_t next_compressed(
+            boost::lexer::detail::internals const& internals_
+          , std::size_t &dfa_state_, bool& bol_, Iterator &start_token_
+          , Iterator const& end_, std::size_t& unique_id_, bool multi_state_)
+        {
+            switch (internals_._compressed[dfa_state_]->_width)
+            {
+            case 1:
+                return next_narrow<boost::uint8_t>(internals_, dfa_state_
+                  , bol_, start_token_, end_, unique_id_, multi_state_);
+            case 2:
+                return next_narrow<boost::uint16_t>(internals_, dfa_state_
+                  , bol_, start_token_, end_, unique_id_, multi_state_);
+            default:
+                break;
+            }
+            return next_narrow<boost::uint32_t>(internals_, dfa_state_
+              , bol_, start_token_, end_, unique_id_, multi_state_);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        //  Same matching algorithm as next() above, but walking the narrow, 
+        //  row-deduplicated tables. If multi_state_ is true, lexer state 
+        //  changes are honored and tokens with id 0 are skipped.
+        template <typename Cell>
+        static std::size_t next_narrow(
+            boost::lexer::detail::internals const& internals_
+          , std::size_t &dfa_state_, bool& bol_, Iterator &start_token_
+          , Iterator const& end_, std::size_t& unique_id_, bool multi_state_)
+        {
+            typedef boost::lexer::detail::compressed_dfa compressed_dfa;
+            typedef typename 
+                boost::lexer::char_traits<char_type>::index_type 
+            index_type;
+
+            bool bol = bol_;
+
+        again:
+            compressed_dfa const& dfa_ = *internals_._compressed[dfa_state_];
+            Cell const* lookup_ = dfa_.cells(static_cast<Cell const*>(0));
+            Cell const* states_ = lookup_ + dfa_._states_offset;
+            Cell const* rows_ = lookup_ + dfa_._rows_offset;
+            std::size_t const columns_ = dfa_._columns;
+            std::size_t const* accept_ = dfa_._accept;
+            detail::self_loop const* loops_ = dfa_._loops;
+
+            // state 0 is the 'jam' state, state 1 the start state
+            Cell const* ptr_ = states_ + compressed_dfa::state_cells;
+            Iterator curr_ = start_token_;
+            bool end_state_ = ptr_[compressed_dfa::end_state_cell] != 0;
+            std::size_t id_ = accept_[3];
+            std::size_t uid_ = accept_[4];
+            std::size_t end_start_state_ = dfa_state_;
+            bool end_bol_ = bol_;
+            Iterator end_token_ = start_token_;
+
+            while (curr_ != end_)
+            {
+                std::size_t const BOL_state_ = ptr_[compressed_dfa::bol_cell];
+                std::size_t const EOL_state_ = ptr_[compressed_dfa::eol_cell];
+                std::size_t state_ = 0;
+
+                if (BOL_state_ && bol)
+                {
+                    state_ = BOL_state_;
+                }
+                else if (EOL_state_ && *curr_ == '\n')
+                {
+                    state_ = EOL_state_;
+                }
+                else
+                {
+                    index_type index = 
+                        boost::lexer::char_traits<char_type>::call(*curr_++);
+                    bol = (index == '\n') ? true : false;
+                    state_ = rows_[ptr_[compressed_dfa::row_cell] * columns_ + 
+                        lookup_[static_cast<std::size_t>(index)]];
+
+                    if (state_ == 0)
+                    {
+                        break;
+                    }
+
+                    detail::skip_self_loop(loops_, state_, curr_, end_, bol);
+                }
+
+                ptr_ = states_ + state_ * compressed_dfa::state_cells;
+
+                if (ptr_[compressed_dfa::end_state_cell])
+                {
+                    end_state_ = true;
+                    id_ = accept_[state_ * 3];
+                    uid_ = accept_[state_ * 3 + 1];
+                    end_start_state_ = accept_[state_ * 3 + 2];
+                    end_bol_ = bol;
+                    end_token_ = curr_;
+                }
+            }
+
+            std::size_t const EOL_state_ = ptr_[compressed_dfa::eol_cell];
+
+            if (EOL_state_ && curr_ == end_)
+            {
+                ptr_ = states_ + EOL_state_ * compressed_dfa::state_cells;
+
+                if (ptr_[compressed_dfa::end_state_cell])
+                {
+                    end_state_ = true;
+                    id_ = accept_[EOL_state_ * 3];
+                    uid_ = accept_[EOL_state_ * 3 + 1];
+                    end_start_state_ = accept_[EOL_state_ * 3 + 2];
+                    end_bol_ = bol;
+                    end_token_ = curr_;
+                }
+            }
+
+            if (end_state_) {
+                // return longest match
+                start_token_ = end_token_;
+
+                if (multi_state_)
+                {
+                    dfa_state_ = end_start_state_;
+
+                    if (id_ == 0)
+                    {
+                        bol = end_bol_;
+                        goto again;
+                    }
+                }
+                bol_ = end_bol_;
+            }
+            else {
+                bol_ = (*start_token_ == '\n') ? true : false;
+                id_ = boost::lexer::npos;
+                uid_ = boost::lexer::npos;
+            }
+
             unique_id_ = uid_;
             return id_;
         }
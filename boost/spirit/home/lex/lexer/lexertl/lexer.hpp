@@ -15,12 +15,15 @@
 #include <boost/spirit/home/support/detail/lexer/generator.hpp>
 #include <boost/spirit/home/support/detail/lexer/rules.hpp>
 #include <boost/spirit/home/support/detail/lexer/consts.hpp>
+#include <boost/spirit/home/support/detail/lexer/image.hpp>
 #include <boost/spirit/home/support/unused.hpp>
 
 #include <boost/spirit/home/lex/lexer/lexertl/token.hpp>
+#include <boost/spirit/home/lex/lexer/lexertl/compact_token.hpp>
 #include <boost/spirit/home/lex/lexer/lexertl/functor.hpp>
 #include <boost/spirit/home/lex/lexer/lexertl/functor_data.hpp>
 #include <boost/spirit/home/lex/lexer/lexertl/iterator.hpp>
+#include <boost/spirit/home/lex/lexer/lexertl/parallel_tokenizer.hpp>
 #if defined(BOOST_SPIRIT_LEXERTL_DEBUG)
 #include <boost/spirit/home/support/detail/lexer/debug.hpp>
 #endif
@@ -210,14 +213,42 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
             return iterator_type(); 
         }
 
+        //  Tokenize the whole input sequence at once, appending the generated
+        //  tokens to the given container, using up to 'threads' threads (see
+        //  lexertl::tokenize_all).
+        template <typename Container>
+        bool tokenize_all(Iterator& first, Iterator const& last
+          , Container& tokens, char_type const* initial_state = 0
+          , std::size_t threads = 1) const
+        {
+            if (!init_dfa())    // never minimize DFA for dynamic lexers
+                return false;
+
+            iterator_data_type iterator_data(state_machine_, rules_, actions_);
+            return lexertl::tokenize_all<Functor>(
+                iterator_data, first, last, tokens, initial_state, threads);
+        }
+
     protected:
         //  Lexer instances can be created by means of a derived class only.
         lexer(unsigned int flags) 
           : flags_(detail::map_flags(flags))
           , rules_(flags_)
+          , compress_dfa_((flags & match_flags::match_compress_dfa) != 0)
+          , parallel_dfa_((flags & match_flags::match_parallel_dfa) != 0)
           , initialized_dfa_(false)
         {}
 
+        //  The semantic actions are accessible by derived lexers only.
+        typename Functor::semantic_actions_type& semantic_actions() 
+        {
+            return actions_;
+        }
+        typename Functor::semantic_actions_type const& semantic_actions() const
+        {
+            return actions_;
+        }
+
     public:
         // interface for token definition management
         std::size_t add_token(char_type const* state, char_type tokendef, 
@@ -321,13 +352,24 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
         //            is little point in calling minimise."
         // Go figure.
         bool init_dfa(bool minimize = false) const
+        {
+            return init_dfa(minimize, parallel_dfa_ ? 0 : 1);
+        }
+
+        //  Build the DFA using up to 'threads' threads, where 0 means one 
+        //  thread per processor. The lexer states (and the states of the DFA 
+        //  of each lexer state) are built concurrently only if 
+        //  BOOST_SPIRIT_THREADSAFE is defined.
+        bool init_dfa(bool minimize, std::size_t threads) const
         {
             if (!initialized_dfa_) {
                 state_machine_.clear();
                 typedef boost::lexer::basic_generator<char_type> generator;
-                generator::build (rules_, state_machine_);
+                generator::build (rules_, state_machine_, threads);
                 if (minimize)
-                    generator::minimise (state_machine_);
+                    generator::minimise (state_machine_, threads);
+                if (compress_dfa_)
+                    generator::compress (state_machine_);
 
 #if defined(BOOST_SPIRIT_LEXERTL_DEBUG)
                 boost::lexer::debug::dump(state_machine_, std::cerr);
@@ -337,11 +379,54 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
             return true;
         }
 
+        //  Write the DFA built from the current token definitions as a 
+        //  binary image. Other lexer instances having the same token 
+        //  definitions can adopt this image instead of building the DFA 
+        //  again (see adopt_dfa_image below). Writing an image switches this
+        //  lexer to the compressed DFA tables (see match_compress_dfa).
+        bool save_dfa_image(std::ostream& os) const
+        {
+            if (!init_dfa())
+                return false;
+
+            if (state_machine_.data()._compressed->empty())
+                boost::lexer::basic_generator<char_type>::compress(state_machine_);
+
+            boost::lexer::write_image(state_machine_, os
+              , boost::lexer::image_fingerprint(rules_));
+            return os.good();
+        }
+
+        //  Use the DFA stored in the binary image at 'data' (as written by 
+        //  save_dfa_image above), for instance after memory mapping the 
+        //  image file. The image is not copied, it has to stay valid as long
+        //  as this lexer is in use. 'data' must be aligned to 8 bytes. 
+        //  Returns false if the image is not usable on this platform, if it 
+        //  was created from different token definitions or if it is 
+        //  truncated or corrupt, in which case the DFA will be built as 
+        //  usual. An adopted image holds the compressed tables only, so 
+        //  generate_static() fails for this lexer.
+        bool adopt_dfa_image(void const* data, std::size_t size)
+        {
+            try {
+                boost::lexer::adopt_image(state_machine_, data, size
+                  , boost::lexer::image_fingerprint(rules_));
+            }
+            catch (boost::lexer::runtime_error const&) {
+                initialized_dfa_ = false;
+                return false;
+            }
+            initialized_dfa_ = true;
+            return true;
+        }
+
     private:
         // lexertl specific data
         mutable boost::lexer::basic_state_machine<char_type> state_machine_;
         boost::lexer::regex_flags flags_;
         basic_rules_type rules_;
+        bool compress_dfa_;
+        bool parallel_dfa_;
 
         typename Functor::semantic_actions_type actions_;
         mutable bool initialized_dfa_;
@@ -381,6 +466,49 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
           : lexer<Token, Iterator, Functor>(flags) {}
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    //
+    //  The typed_actor_lexer class is a variant of the actor_lexer class 
+    //  above, where the semantic actions are not attached to the token_def
+    //  definitions, but are implemented by a single function object of the 
+    //  type Actions. For every matched token it is invoked as
+    //
+    //      actions(start, end, pass, id, ctx);
+    //
+    //  (see the general form of lexer semantic actions), where it usually 
+    //  dispatches on the token id using a switch statement. As the type of 
+    //  the function object is known at compile time, its invocation can be 
+    //  inlined, which avoids the overhead of the boost::function objects
+    //  otherwise used to store the semantic actions. The function object is 
+    //  default constructed and accessible using the function actions().
+    //
+    //  This class is supposed to be used as the first and only template 
+    //  parameter while instantiating instances of a lex::lexer class.
+    //
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Actions
+      , typename Token = token<>
+      , typename Iterator = typename Token::iterator_type
+      , typename Functor = functor<Token, lexertl::detail::data, Iterator
+          , typed_actions<Actions> > >
+    class typed_actor_lexer : public lexer<Token, Iterator, Functor>
+    {
+    protected:
+        //  Lexer instances can be created by means of a derived class only.
+        typed_actor_lexer(unsigned int flags) 
+          : lexer<Token, Iterator, Functor>(flags) {}
+
+    public:
+        Actions& actions() 
+        {
+            return this->semantic_actions().actions();
+        }
+        Actions const& actions() const 
+        {
+            return this->semantic_actions().actions();
+        }
+    };
+
 }}}}
 
 #endif
@@ -0,0 +1,298 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(BOOST_SPIRIT_LEX_PARALLEL_TOKENIZER_OCT_16_2026_0600PM)
+#define BOOST_SPIRIT_LEX_PARALLEL_TOKENIZER_OCT_16_2026_0600PM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/detail/iterator.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/spirit/home/support/unused.hpp>
+#include <boost/spirit/home/support/detail/lexer/parallel.hpp>
+#include <boost/spirit/home/lex/lexer/lexertl/iterator.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace boost { namespace spirit { namespace lex { namespace lexertl
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        //  The tokens of one chunk of the input, matched speculatively
+        //  starting in the INITIAL state. For the first tokens the position
+        //  and the lexer state they were matched from are kept, allowing to
+        //  find the point where the sequential token stream reaches the same
+        //  lexer configuration. If this does not happen within these tokens
+        //  the whole chunk is matched again.
+        ///////////////////////////////////////////////////////////////////////
+        std::size_t const sync_tokens = 64;
+
+        template <typename Iterator, typename Token>
+        struct token_chunk
+        {
+            token_chunk(Iterator const& first_, Iterator const& last_
+                  , std::size_t state_)
+              : first(first_), last(last_), end(first_), state(state_)
+              , end_state(state_), failed(false) {}
+
+            Iterator first, last;       // chunk boundaries
+            Iterator end;               // where matching stopped
+            std::size_t state;          // state matching started in
+            std::size_t end_state;      // state matching stopped in
+            bool failed;                // matching stopped at no match
+
+            std::vector<Token> tokens;
+            std::vector<Iterator> starts;
+            std::vector<std::size_t> states;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        //  Match the tokens starting inside a single chunk (the last token
+        //  may extend beyond the end of the chunk).
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Functor, typename IteratorData, typename Chunk>
+        struct tokenize_chunk
+        {
+            typedef typename Functor::iterator_type base_iterator_type;
+            typedef typename Functor::result_type token_type;
+
+            tokenize_chunk(IteratorData const& iterdata_
+                  , base_iterator_type const& last, std::vector<Chunk>& chunks)
+              : iterdata_(iterdata_), last_(last), chunks_(chunks) {}
+
+            void operator()(std::size_t index)
+            {
+                Chunk& c = chunks_[index];
+                base_iterator_type first = c.first;
+
+                bulk_input<Functor> input(iterdata_, first, last_);
+                typename Functor::shared& data = input.shared()->ftor;
+                data.set_state(c.state);
+                if (0 != index)
+                    data.reset_bol(true);     // chunks start after a newline
+
+                token_type t;
+                while (first < c.last)
+                {
+                    if (c.starts.size() <= sync_tokens) {
+                        c.starts.push_back(first);
+                        c.states.push_back(data.get_state());
+                    }
+
+                    Functor::get_next(input, t);
+                    if (t == input.ftor.eof)
+                        break;
+                    if (!token_is_valid(t)) {
+                        c.failed = true;
+                        break;
+                    }
+                    c.tokens.push_back(t);
+                }
+
+                if (c.starts.size() > c.tokens.size()) {
+                    c.starts.resize(c.tokens.size());
+                    c.states.resize(c.tokens.size());
+                }
+                c.end = first;
+                c.end_state = data.get_state();
+            }
+
+            IteratorData const& iterdata_;
+            base_iterator_type last_;
+            std::vector<Chunk>& chunks_;
+
+        private:
+            // silence MSVC warning C4512: assignment operator could not be generated
+            tokenize_chunk& operator= (tokenize_chunk const&);
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        //  Split the input into up to 'count' chunks, each of those starting
+        //  right after a newline. Chunks are merged if there is no newline
+        //  in between.
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Chunk, typename Iterator>
+        inline void
+        split_chunks(Iterator const& first, Iterator const& last
+          , std::size_t count, std::size_t state, std::vector<Chunk>& chunks)
+        {
+            typedef typename boost::detail::iterator_traits<Iterator>::value_type
+                char_type;
+
+            std::size_t const size = std::size_t(last - first);
+            Iterator start = first;
+            for (std::size_t i = 1; i < count; ++i)
+            {
+                Iterator it = first + i * (size / count);
+                if (it < start)
+                    continue;
+
+                Iterator const next = first + (i + 1) * (size / count);
+                it = std::find(it, next, char_type('\n'));
+                if (it == next || ++it == last)
+                    continue;
+
+                chunks.push_back(Chunk(start, it, chunks.empty() ? state : 0));
+                start = it;
+            }
+            chunks.push_back(Chunk(start, last, chunks.empty() ? state : 0));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        //  The tokens of all chunks are matched concurrently, where all but
+        //  the first chunk are matched speculatively. The results are then
+        //  stitched together sequentially: starting from where the previous
+        //  chunk stopped, tokens are matched again until a token of the
+        //  current chunk is reached which was matched from the same position
+        //  and lexer state. From there on the speculative results are
+        //  identical to what sequential matching would produce.
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Functor, typename IteratorData, typename Container>
+        inline bool
+        tokenize_all(IteratorData const& iterdata_
+          , typename Functor::iterator_type& first
+          , typename Functor::iterator_type const& last, Container& tokens
+          , typename Functor::char_type const* initial_state
+          , std::size_t threads, mpl::true_)
+        {
+            typedef typename Functor::iterator_type base_iterator_type;
+            typedef typename Functor::result_type token_type;
+            typedef token_chunk<base_iterator_type, token_type> chunk_type;
+
+            // the input used to match tokens at the seams
+            base_iterator_type pos = first;
+            bulk_input<Functor> input(iterdata_, pos, last);
+            typename Functor::shared& data = input.shared()->ftor;
+
+            std::size_t state = 0;
+            if (0 != initial_state)
+                state = Functor::map_state(input, initial_state);
+
+            std::vector<chunk_type> chunks;
+            split_chunks(first, last, boost::lexer::detail::thread_count(threads)
+              , state, chunks);
+
+            tokenize_chunk<Functor, IteratorData, chunk_type>
+                f(iterdata_, last, chunks);
+            boost::lexer::detail::parallel_for(chunks.size(), threads, f);
+
+            token_type t;
+            for (std::size_t i = 0; i < chunks.size(); ++i)
+            {
+                chunk_type& c = chunks[i];
+
+                //  The first chunk was matched in the correct state, all
+                //  others need to be synchronized first.
+                std::size_t k = 0;
+                while (0 != i && pos < c.last)
+                {
+                    k = std::lower_bound(c.starts.begin() + k, c.starts.end()
+                          , pos) - c.starts.begin();
+                    if (k < c.starts.size()) {
+                        if (c.starts[k] == pos && c.states[k] == state)
+                            break;  // the token streams are in sync again
+                    }
+                    else if (c.starts.size() == c.tokens.size() &&
+                        c.end == pos && c.end_state == state)
+                    {
+                        break;      // matching stopped at the same place
+                    }
+
+                    // match the next token sequentially
+                    data.set_state(state);
+                    data.reset_bol(*(pos - 1) == '\n');
+
+                    Functor::get_next(input, t);
+                    if (t == input.ftor.eof) {
+                        first = pos;
+                        return true;
+                    }
+                    if (!token_is_valid(t)) {
+                        first = pos;
+                        return false;
+                    }
+                    tokens.push_back(t);
+                    state = data.get_state();
+                }
+
+                if (0 != i && pos >= c.last)
+                    continue;       // all tokens of this chunk were replaced
+
+                for (/**/; k < c.tokens.size(); ++k)
+                    tokens.push_back(c.tokens[k]);
+
+                pos = c.end;
+                state = c.end_state;
+                if (c.failed) {
+                    first = pos;
+                    return false;
+                }
+
+                std::vector<token_type>().swap(c.tokens);
+                std::vector<base_iterator_type>().swap(c.starts);
+                std::vector<std::size_t>().swap(c.states);
+            }
+
+            first = pos;
+            return true;
+        }
+
+        //  lexers with semantic actions tokenize sequentially
+        template <typename Functor, typename IteratorData, typename Container>
+        inline bool
+        tokenize_all(IteratorData const& iterdata_
+          , typename Functor::iterator_type& first
+          , typename Functor::iterator_type const& last, Container& tokens
+          , typename Functor::char_type const* initial_state
+          , std::size_t, mpl::false_)
+        {
+            return lexertl::tokenize_all<Functor>(iterdata_, first, last
+              , tokens, initial_state);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  This overload of tokenize_all splits the input into chunks at
+    //  newlines, which are matched concurrently using up to 'threads' threads
+    //  (0 means one thread per processor). The generated token sequence is
+    //  identical to the one generated sequentially, including lexer state
+    //  switches. Threads are used only if BOOST_SPIRIT_THREADSAFE is defined,
+    //  the underlying iterator is a random access iterator, and the lexer
+    //  does not have semantic actions (their side effects depend on the
+    //  order of execution). Otherwise the input is tokenized sequentially.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Functor, typename IteratorData, typename Container>
+    inline bool
+    tokenize_all(IteratorData const& iterdata_
+      , typename Functor::iterator_type& first
+      , typename Functor::iterator_type const& last, Container& tokens
+      , typename Functor::char_type const* state, std::size_t threads)
+    {
+        typedef typename Functor::iterator_type base_iterator_type;
+        typedef mpl::and_<
+            is_convertible<
+                typename boost::detail::iterator_traits<
+                    base_iterator_type>::iterator_category
+              , std::random_access_iterator_tag>
+          , is_same<typename Functor::semantic_actions_type, unused_type>
+        > splittable;
+
+        if (1 == boost::lexer::detail::thread_count(threads) || first == last)
+        {
+            return lexertl::tokenize_all<Functor>(iterdata_, first, last
+              , tokens, state);
+        }
+        return detail::tokenize_all<Functor>(iterdata_, first, last, tokens
+          , state, threads, splittable());
+    }
+}}}}
+
+#endif
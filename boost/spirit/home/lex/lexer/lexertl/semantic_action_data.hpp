@@ -10,6 +10,8 @@
 #pragma once
 #endif
 
+#include <boost/spirit/home/support/assert_msg.hpp>
+#include <boost/spirit/home/support/unused.hpp>
 #include <boost/spirit/home/lex/lexer/pass_flags.hpp>
 #include <boost/mpl/bool.hpp>
 #include <boost/function.hpp>
@@ -17,6 +19,15 @@
 
 namespace boost { namespace spirit { namespace lex { namespace lexertl
 { 
+    ///////////////////////////////////////////////////////////////////////////
+    //  Passed as the SupportsActors parameter of the lexertl::functor, this
+    //  makes the lexer invoke a single function object of the type Actions
+    //  for every matched token instead of the semantic actions attached to
+    //  the token definitions (see typed_actor_lexer).
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Actions>
+    struct typed_actions {};
+
     namespace detail
     {
         ///////////////////////////////////////////////////////////////////////
@@ -114,6 +125,64 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
 
             std::vector<std::vector<functor_wrapper_type> > actions_;
         }; 
+
+        // This is used if the lexer invokes the function object of the type 
+        // Actions for all tokens. As its type is known at compile time, the
+        // call can be inlined, avoiding the indirection through the stored 
+        // boost::function objects. The function object usually dispatches 
+        // on the token id using a switch statement.
+        template <typename Actions, typename Iterator, typename Data>
+        struct typed_semantic_actions
+        {
+            typedef unused_type functor_wrapper_type;
+
+            // semantic actions can't be attached to the token definitions
+            template <typename F>
+            void add_action(std::size_t, std::size_t, F) 
+            {
+                BOOST_SPIRIT_ASSERT_MSG(false
+                  , token_definition_actions_not_supported_by_typed_actions
+                  , (F));
+            }
+
+            // invoke the function object for the given token
+            BOOST_SCOPED_ENUM(pass_flags) invoke_actions(std::size_t /*state*/
+              , std::size_t& id, std::size_t /*unique_id*/, Iterator& end
+              , Data& data) const
+            {
+                // set token value 
+                data.set_end(end);
+
+                // Note: all arguments might be changed by the invoked semantic 
+                //       action
+                BOOST_SCOPED_ENUM(pass_flags) match = pass_flags::pass_normal;
+                actions_(data.get_first(), end, match, id, data);
+                return match;
+            }
+
+            Actions& actions() { return actions_; }
+            Actions const& actions() const { return actions_; }
+
+            mutable Actions actions_;
+        }; 
+
+        ///////////////////////////////////////////////////////////////////////
+        //  Return the type used to store the semantic actions based on the 
+        //  SupportsActors parameter of the lexertl::functor.
+        template <typename HasActors, typename Iterator, typename SupportsState
+          , typename Data>
+        struct select_semantic_actions
+        {
+            typedef semantic_actions<Iterator, SupportsState, Data> type;
+        };
+
+        template <typename Actions, typename Iterator, typename SupportsState
+          , typename Data>
+        struct select_semantic_actions<typed_actions<Actions>, Iterator
+          , SupportsState, Data>
+        {
+            typedef typed_semantic_actions<Actions, Iterator, Data> type;
+        };
     }
 
 }}}}
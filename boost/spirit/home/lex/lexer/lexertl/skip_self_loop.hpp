@@ -0,0 +1,180 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(BOOST_SPIRIT_LEXERTL_SKIP_SELF_LOOP_OCT_16_2026_0930AM)
+#define BOOST_SPIRIT_LEXERTL_SKIP_SELF_LOOP_OCT_16_2026_0930AM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/spirit/home/support/detail/lexer/internals.hpp>
+
+#if !defined(BOOST_SPIRIT_LEXERTL_NO_SIMD)
+#if defined(__AVX2__)
+#define BOOST_SPIRIT_LEXERTL_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BOOST_SPIRIT_LEXERTL_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER) && \
+    (defined(BOOST_SPIRIT_LEXERTL_AVX2) || defined(BOOST_SPIRIT_LEXERTL_SSE2))
+#include <intrin.h>
+#endif
+#endif
+
+namespace boost { namespace spirit { namespace lex { namespace lexertl
+{
+    namespace detail
+    {
+        typedef boost::lexer::detail::self_loop self_loop;
+
+#if defined(BOOST_SPIRIT_LEXERTL_AVX2) || defined(BOOST_SPIRIT_LEXERTL_SSE2)
+        ///////////////////////////////////////////////////////////////////////
+        inline unsigned int first_bit(unsigned int mask)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return index;
+#else
+            return __builtin_ctz(mask);
+#endif
+        }
+#endif
+
+        ///////////////////////////////////////////////////////////////////////
+        //  Return the first position in [first, last) not matching the
+        //  self loop of a DFA state. The loops described by up to four
+        //  characters are checked 16 (SSE2) or 32 (AVX2) bytes at a time.
+        inline char const* scan_self_loop(self_loop const& loop
+          , char const* first, char const* last)
+        {
+            bool const any_of = loop._kind == self_loop::any_of;
+
+            switch (loop._kind)
+            {
+            case self_loop::any_of:
+            case self_loop::none_of:
+                {
+#if defined(BOOST_SPIRIT_LEXERTL_AVX2)
+                    __m256i const c0 = _mm256_set1_epi8(char(loop._chars[0]));
+                    __m256i const c1 = _mm256_set1_epi8(char(loop._chars[1]));
+                    __m256i const c2 = _mm256_set1_epi8(char(loop._chars[2]));
+                    __m256i const c3 = _mm256_set1_epi8(char(loop._chars[3]));
+
+                    while (last - first >= 32)
+                    {
+                        __m256i const v = _mm256_loadu_si256(
+                            reinterpret_cast<__m256i const*>(first));
+                        __m256i const m = _mm256_or_si256(
+                            _mm256_or_si256(_mm256_cmpeq_epi8(v, c0)
+                              , _mm256_cmpeq_epi8(v, c1))
+                          , _mm256_or_si256(_mm256_cmpeq_epi8(v, c2)
+                              , _mm256_cmpeq_epi8(v, c3)));
+                        unsigned int mask =
+                            static_cast<unsigned int>(_mm256_movemask_epi8(m));
+
+                        if (any_of)
+                            mask = ~mask;
+                        if (mask)
+                            return first + first_bit(mask);
+                        first += 32;
+                    }
+#elif defined(BOOST_SPIRIT_LEXERTL_SSE2)
+                    __m128i const c0 = _mm_set1_epi8(char(loop._chars[0]));
+                    __m128i const c1 = _mm_set1_epi8(char(loop._chars[1]));
+                    __m128i const c2 = _mm_set1_epi8(char(loop._chars[2]));
+                    __m128i const c3 = _mm_set1_epi8(char(loop._chars[3]));
+
+                    while (last - first >= 16)
+                    {
+                        __m128i const v = _mm_loadu_si128(
+                            reinterpret_cast<__m128i const*>(first));
+                        __m128i const m = _mm_or_si128(
+                            _mm_or_si128(_mm_cmpeq_epi8(v, c0)
+                              , _mm_cmpeq_epi8(v, c1))
+                          , _mm_or_si128(_mm_cmpeq_epi8(v, c2)
+                              , _mm_cmpeq_epi8(v, c3)));
+                        unsigned int mask =
+                            static_cast<unsigned int>(_mm_movemask_epi8(m));
+
+                        if (any_of)
+                            mask ^= 0xffff;
+                        if (mask)
+                            return first + first_bit(mask);
+                        first += 16;
+                    }
+#endif
+                    for (/**/; first != last; ++first)
+                    {
+                        unsigned char const ch =
+                            static_cast<unsigned char>(*first);
+                        bool const found = ch == loop._chars[0] ||
+                            ch == loop._chars[1] || ch == loop._chars[2] ||
+                            ch == loop._chars[3];
+
+                        if (found != any_of)
+                            break;
+                    }
+                }
+                break;
+
+            case self_loop::bitmap:
+                for (/**/; first != last; ++first)
+                {
+                    unsigned char const ch = static_cast<unsigned char>(*first);
+                    if (!(loop._bitmap[ch / 8] & (1 << (ch % 8))))
+                        break;
+                }
+                break;
+
+            default:
+                break;
+            }
+            return first;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        //  After the tokeniser entered the DFA state 'state' skip all
+        //  following characters which would keep the DFA in that state. This
+        //  is done for contiguous 8 bit character input only, for all other
+        //  iterator types this is a no-op.
+        template <typename Iterator>
+        inline void skip_self_loop(self_loop const*, std::size_t
+          , Iterator&, Iterator const&, bool&)
+        {
+        }
+
+        inline void skip_self_loop(self_loop const* loops
+          , std::size_t state, char const*& curr, char const* const& last
+          , bool& bol)
+        {
+            if (0 == loops || curr == last)
+                return;
+
+            self_loop const& loop = loops[state];
+            if (loop._kind == self_loop::no_loop)
+                return;
+
+            char const* first = curr;
+            curr = scan_self_loop(loop, curr, last);
+            if (curr != first)
+                bol = curr[-1] == '\n';
+        }
+
+        inline void skip_self_loop(self_loop const* loops
+          , std::size_t state, char*& curr, char* const& last, bool& bol)
+        {
+            char const* first = curr;
+            skip_self_loop(loops, state, first, last, bol);
+            curr += first - curr;
+        }
+    }
+}}}}
+
+#endif
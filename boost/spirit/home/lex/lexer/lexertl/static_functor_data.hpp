@@ -39,7 +39,7 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
         ///////////////////////////////////////////////////////////////////////
         template <typename Iterator, typename HasActors, typename HasState
           , typename TokenValue>
-        class static_data;    // no default specialization
+        class static_data;    // supports actors, defined below
 
         ///////////////////////////////////////////////////////////////////////
         //  doesn't support no state and no actors
@@ -287,13 +287,16 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
         };
 
         ///////////////////////////////////////////////////////////////////////
-        //  does support actors, but may have no state
-        template <typename Iterator, typename HasState, typename TokenValue>
-        class static_data<Iterator, mpl::true_, HasState, TokenValue> 
+        //  does support actors, but may have no state (HasActors is either
+        //  mpl::true_ or typed_actions<>)
+        template <typename Iterator, typename HasActors, typename HasState
+          , typename TokenValue>
+        class static_data
           : public static_data<Iterator, mpl::false_, HasState, TokenValue>
         {
         public:
-            typedef semantic_actions<Iterator, HasState, static_data>
+            typedef typename select_semantic_actions<HasActors, Iterator, HasState
+              , static_data>::type
                 semantic_actions_type;
 
         protected:
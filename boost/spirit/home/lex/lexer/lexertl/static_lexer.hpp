@@ -11,9 +11,11 @@
 #endif
 
 #include <boost/spirit/home/lex/lexer/lexertl/token.hpp>
+#include <boost/spirit/home/lex/lexer/lexertl/compact_token.hpp>
 #include <boost/spirit/home/lex/lexer/lexertl/functor.hpp>
 #include <boost/spirit/home/lex/lexer/lexertl/static_functor_data.hpp>
 #include <boost/spirit/home/lex/lexer/lexertl/iterator.hpp>
+#include <boost/spirit/home/lex/lexer/lexertl/parallel_tokenizer.hpp>
 #include <boost/spirit/home/lex/lexer/lexertl/static_version.hpp>
 #if defined(BOOST_SPIRIT_DEBUG)
 #include <boost/spirit/home/support/detail/lexer/debug.hpp>
@@ -189,10 +191,37 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
             return iterator_type(); 
         }
 
+        //  Tokenize the whole input sequence at once, appending the generated
+        //  tokens to the given container, using up to 'threads' threads (see
+        //  lexertl::tokenize_all).
+        template <typename Iterator_, typename Container>
+        bool tokenize_all(Iterator_& first, Iterator_ const& last
+          , Container& tokens, char_type const* initial_state = 0
+          , std::size_t threads = 1) const
+        {
+            iterator_data_type iterator_data( 
+                    &tables_type::template next<Iterator_>, actions_
+                  , &tables_type::state_name, tables_type::state_count()
+                  , tables_type::supports_bol
+                );
+            return lexertl::tokenize_all<Functor>(
+                iterator_data, first, last, tokens, initial_state, threads);
+        }
+
     protected:
         //  Lexer instances can be created by means of a derived class only.
         static_lexer(unsigned int) : unique_id_(0) {}
 
+        //  The semantic actions are accessible by derived lexers only.
+        typename Functor::semantic_actions_type& semantic_actions() 
+        {
+            return actions_;
+        }
+        typename Functor::semantic_actions_type const& semantic_actions() const
+        {
+            return actions_;
+        }
+
     public:
         // interface for token definition management
         std::size_t add_token (char_type const*, char_type, std::size_t
@@ -231,6 +260,7 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
         }
 
         bool init_dfa(bool minimize = false) const { return true; }
+        bool init_dfa(bool minimize, std::size_t threads) const { return true; }
 
     private:
         typename Functor::semantic_actions_type actions_;
@@ -274,6 +304,40 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
         {}
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    //
+    //  The static_typed_actor_lexer class is the equivalent of the
+    //  typed_actor_lexer class for statically generated lexers: all tokens
+    //  are handled by a single function object of the type Actions (see
+    //  lexertl::typed_actor_lexer).
+    //
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Actions
+      , typename Token = token<>
+      , typename LexerTables = static_::lexer
+      , typename Iterator = typename Token::iterator_type
+      , typename Functor = functor<Token, detail::static_data, Iterator
+          , typed_actions<Actions> > >
+    class static_typed_actor_lexer 
+      : public static_lexer<Token, LexerTables, Iterator, Functor>
+    {
+    protected:
+        // Lexer instances can be created by means of a derived class only.
+        static_typed_actor_lexer(unsigned int flags) 
+          : static_lexer<Token, LexerTables, Iterator, Functor>(flags) 
+        {}
+
+    public:
+        Actions& actions() 
+        {
+            return this->semantic_actions().actions();
+        }
+        Actions const& actions() const 
+        {
+            return this->semantic_actions().actions();
+        }
+    };
+
 }}}}
 
 #endif
@@ -21,6 +21,7 @@
 #include <boost/spirit/home/lex/reference.hpp>
 #include <boost/spirit/home/lex/lexer_type.hpp>
 #include <boost/spirit/home/lex/lexer/terminals.hpp>
+#include <boost/spirit/home/lex/detail/base_iterator.hpp>
 
 #include <boost/fusion/include/vector.hpp>
 #include <boost/mpl/if.hpp>
@@ -70,7 +71,8 @@ namespace boost { namespace spirit { namespace lex
             //  attribute type, or the pair of iterators from the match of the 
             //  corresponding token (if no attribute type has been specified),
             //  or unused_type (if omit has been specified).
-            typedef typename Iterator::base_iterator_type iterator_type;
+            typedef typename lex::detail::base_iterator<Iterator>::type
+                iterator_type;
             typedef typename mpl::if_<
                 traits::not_is_unused<Attribute>
               , typename mpl::if_<
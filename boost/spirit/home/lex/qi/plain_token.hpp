@@ -18,6 +18,7 @@
 #include <boost/spirit/home/qi/parser.hpp>
 #include <boost/spirit/home/qi/meta_compiler.hpp>
 #include <boost/spirit/home/qi/detail/assign_to.hpp>
+#include <boost/spirit/home/lex/detail/base_iterator.hpp>
 #include <boost/range/iterator_range.hpp>
 #include <boost/fusion/include/vector.hpp>
 #include <boost/fusion/include/at.hpp>
@@ -62,7 +63,8 @@ namespace boost { namespace spirit { namespace qi
         template <typename Context, typename Iterator>
         struct attribute
         {
-            typedef typename Iterator::base_iterator_type iterator_type;
+            typedef typename lex::detail::base_iterator<Iterator>::type
+                iterator_type;
             typedef iterator_range<iterator_type> type;
         };
 
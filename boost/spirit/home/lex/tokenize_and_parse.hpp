@@ -320,6 +320,60 @@ namespace boost { namespace spirit { namespace lex
         return (iter == end) ? true : false;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    //
+    //  The tokenize_all() function tokenizes all of the given input sequence
+    //  at once, storing the generated tokens into a container (usually a 
+    //  std::vector<Lexer::token_type>). The lexer is invoked directly, 
+    //  without the multi_pass machinery used by the token iterator. The
+    //  iterators of the container can be passed to a parser afterwards,
+    //  which makes backtracking over the tokens essentially free:
+    //
+    //      std::vector<token_type> tokens;
+    //      if (lex::tokenize_all(first, last, lexer, tokens)) {
+    //          std::vector<token_type>::const_iterator it = tokens.begin();
+    //          qi::parse(it, tokens.end(), grammar);
+    //      }
+    //
+    //  Note: as the parser does not see the lexer anymore, parser components
+    //        changing the lexer state (lex::in_state, lex::set_state) can't
+    //        be used with the tokens generated by this function.
+    //
+    //  The function returns true if all of the input sequence was converted
+    //  into tokens. 
+    //
+    //  first, last:    The pair of iterators spanning the underlying input 
+    //                  sequence to tokenize.
+    //                  On exit the iterator 'first' will be updated to the 
+    //                  position right after the last successfully matched 
+    //                  token. 
+    //  lex:            The lexer object (encoding the token definitions) to be
+    //                  used to convert the input sequence into a sequence of 
+    //                  tokens. 
+    //  tokens:         The container the generated tokens are appended to 
+    //                  (using push_back()).
+    //  initial_state:  The name of the state the lexer should start matching.
+    //                  The default value is zero, causing the lexer to start 
+    //                  in its 'INITIAL' state.
+    //  threads:        The number of threads to use (0 means one thread per
+    //                  processor). The input is split into chunks at newlines,
+    //                  which are tokenized concurrently, generating the same 
+    //                  tokens as if tokenized sequentially. This requires 
+    //                  BOOST_SPIRIT_THREADSAFE to be defined, random access 
+    //                  iterators, and a lexer without semantic actions, 
+    //                  otherwise the input is tokenized by a single thread.
+    //
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Iterator, typename Lexer, typename Container>
+    inline bool
+    tokenize_all(Iterator& first, Iterator last, Lexer const& lex
+      , Container& tokens
+      , typename Lexer::char_type const* initial_state = 0
+      , std::size_t threads = 1)
+    {
+        return lex.tokenize_all(first, last, tokens, initial_state, threads);
+    }
+
 }}}
 
 #endif
@@ -14,6 +14,7 @@
 #include <boost/spirit/home/qi/meta_compiler.hpp>
 #include <boost/spirit/home/qi/parser.hpp>
 #include <boost/spirit/home/qi/detail/attributes.hpp>
+#include <boost/spirit/home/qi/detail/first_set.hpp>
 #include <boost/spirit/home/support/argument.hpp>
 #include <boost/spirit/home/support/context.hpp>
 #include <boost/spirit/home/support/unused.hpp>
@@ -125,6 +126,24 @@ namespace boost { namespace spirit
     };
 }}
 
+namespace boost { namespace spirit { namespace qi { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // the action is never invoked if its subject fails
+    template <typename Subject, typename Action>
+    struct first_set<action<Subject, Action> >
+    {
+        typedef typename first_set<Subject>::is_known is_known;
+        typedef typename first_set<Subject>::skips_on_failure skips_on_failure;
+
+        static bool
+        call(action<Subject, Action> const& component, char_bitset& chars)
+        {
+            return first_set<Subject>::call(component.subject, chars);
+        }
+    };
+}}}}
+
 namespace boost { namespace spirit { namespace traits
 {
     ///////////////////////////////////////////////////////////////////////////
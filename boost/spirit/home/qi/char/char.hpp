@@ -23,6 +23,7 @@
 #include <boost/spirit/home/qi/meta_compiler.hpp>
 #include <boost/spirit/home/qi/auxiliary/lazy.hpp>
 #include <boost/spirit/home/qi/detail/enable_lit.hpp>
+#include <boost/spirit/home/qi/detail/first_set.hpp>
 #include <boost/fusion/include/at.hpp>
 #include <boost/mpl/if.hpp>
 #include <boost/mpl/assert.hpp>
@@ -610,4 +611,22 @@ namespace boost { namespace spirit { namespace qi
     };
 }}}
 
+namespace boost { namespace spirit { namespace qi { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename CharEncoding, bool no_attribute, bool no_case>
+    struct first_set<literal_char<CharEncoding, no_attribute, no_case> >
+      : char_parser_first_set<
+            literal_char<CharEncoding, no_attribute, no_case> > {};
+
+    template <typename CharEncoding, bool no_case>
+    struct first_set<char_range<CharEncoding, no_case> >
+      : char_parser_first_set<char_range<CharEncoding, no_case> > {};
+
+    template <typename CharEncoding, bool no_attribute, bool no_case>
+    struct first_set<char_set<CharEncoding, no_attribute, no_case> >
+      : char_parser_first_set<
+            char_set<CharEncoding, no_attribute, no_case> > {};
+}}}}
+
 #endif
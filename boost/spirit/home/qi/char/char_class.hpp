@@ -13,6 +13,7 @@
 
 #include <boost/spirit/home/qi/char/char_parser.hpp>
 #include <boost/spirit/home/qi/domain.hpp>
+#include <boost/spirit/home/qi/detail/first_set.hpp>
 #include <boost/spirit/home/support/char_class.hpp>
 #include <boost/spirit/home/support/common_terminals.hpp>
 #include <boost/spirit/home/support/info.hpp>
@@ -115,4 +116,20 @@ namespace boost { namespace spirit { namespace qi
     };
 }}}
 
+namespace boost { namespace spirit { namespace qi { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // the classification of non-ASCII characters may depend on the locale
+    // in effect at parse time, so these are assumed to match
+    template <typename Tag>
+    struct first_set<char_class<Tag> >
+      : char_parser_first_set<char_class<Tag> >
+    {
+        static bool testable(char_class<Tag> const&, char ch)
+        {
+            return static_cast<unsigned char>(ch) < 0x80;
+        }
+    };
+}}}}
+
 #endif
@@ -16,8 +16,10 @@
 #include <boost/spirit/home/qi/detail/assign_to.hpp>
 #include <boost/spirit/home/qi/meta_compiler.hpp>
 #include <boost/spirit/home/qi/skip_over.hpp>
+#include <boost/spirit/home/qi/detail/first_set.hpp>
 #include <boost/spirit/home/support/unused.hpp>
 #include <boost/spirit/home/support/info.hpp>
+#include <boost/mpl/if.hpp>
 
 namespace boost { namespace spirit
 {
@@ -154,4 +156,27 @@ namespace boost { namespace spirit { namespace qi
     };
 }}}
 
+namespace boost { namespace spirit { namespace qi { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Positive>
+    struct negated_first_set
+      : char_parser_first_set<negated_char_parser<Positive> >
+    {
+        static bool
+        testable(negated_char_parser<Positive> const& component, char ch)
+        {
+            return first_set<Positive>::testable(component.positive, ch);
+        }
+    };
+
+    template <typename Positive>
+    struct first_set<negated_char_parser<Positive> >
+      : mpl::if_<
+            has_first_set<Positive>
+          , negated_first_set<Positive>
+          , first_set<unused_type>
+        >::type {};
+}}}}
+
 #endif
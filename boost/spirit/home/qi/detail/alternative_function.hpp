@@ -15,8 +15,24 @@
 #include <boost/spirit/home/qi/detail/assign_to.hpp>
 #include <boost/spirit/home/support/unused.hpp>
 #include <boost/spirit/home/qi/detail/attributes.hpp>
+#include <boost/spirit/home/qi/detail/first_set.hpp>
+#include <boost/spirit/home/qi/skip_over.hpp>
 #include <boost/variant.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/detail/iterator.hpp>
+#include <boost/fusion/include/for_each.hpp>
+#include <boost/fusion/include/size.hpp>
+#include <boost/fusion/include/mpl.hpp>
+#include <boost/mpl/and.hpp>
 #include <boost/mpl/bool.hpp>
+#include <boost/mpl/end.hpp>
+#include <boost/mpl/find_if.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/mpl/not.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/shared_ptr.hpp>
 
 namespace boost { namespace spirit { namespace qi { namespace detail
 {
@@ -103,6 +119,212 @@ namespace boost { namespace spirit { namespace qi { namespace detail
         alternative_function& operator= (alternative_function const&);
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    //  The alternative parser dispatches on the first character of char
+    //  input if at least one of its (at most 64) elements exposes the set of
+    //  characters it can start with (see first_set). Define
+    //  BOOST_SPIRIT_QI_NO_FIRST_CHAR_DISPATCH to always try all alternatives.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Elements>
+    struct use_first_char_table
+#if !defined(BOOST_SPIRIT_QI_NO_FIRST_CHAR_DISPATCH)
+      : mpl::and_<
+            mpl::bool_<(fusion::result_of::size<Elements>::value <= 64)>
+          , mpl::not_<is_same<
+                typename mpl::find_if<Elements, has_first_set<mpl::_1> >::type
+              , typename mpl::end<Elements>::type> >
+        >
+#else
+      : mpl::false_
+#endif
+    {};
+
+    template <typename Elements, typename Iterator>
+    struct use_first_char_dispatch
+      : mpl::and_<
+            use_first_char_table<Elements>
+          , is_same<
+                typename remove_const<typename boost::detail::
+                    iterator_traits<Iterator>::value_type>::type
+              , char>
+        >
+    {};
+
+    // the jump table: a mask of the alternatives to try for each character
+    // and for the end of the input
+    template <typename Elements>
+    struct first_char_table
+    {
+        typedef typename mpl::if_c<
+            (fusion::result_of::size<Elements>::value <= 32)
+          , boost::uint32_t, boost::uint64_t>::type
+        mask_type;
+
+        // index of the entry used at the end of the input
+        static int const end_of_input = 256;
+
+        first_char_table(Elements const& elements)
+          : skips(0)
+        {
+            for (int i = 0; i <= end_of_input; ++i)
+                candidates[i] = 0;
+
+            mask_type bit = 1;
+            fusion::for_each(elements, add_element(*this, bit));
+        }
+
+        struct add_element
+        {
+            add_element(first_char_table& table, mask_type& bit)
+              : table(table), bit(bit) {}
+
+            template <typename Component>
+            void operator()(Component const& component) const
+            {
+                char_bitset chars;
+                if (first_set<Component>::call(component, chars))
+                {
+                    for (int i = 0; i != end_of_input; ++i)
+                    {
+                        if (chars.test(i))
+                            table.candidates[i] |= bit;
+                    }
+                    if (first_set<Component>::skips_on_failure::value)
+                        table.skips |= bit;
+                }
+                else
+                {
+                    // this one has to be tried always
+                    for (int i = 0; i <= end_of_input; ++i)
+                        table.candidates[i] |= bit;
+                }
+                bit <<= 1;
+            }
+
+            first_char_table& table;
+            mask_type& bit;
+
+        private:
+            // silence MSVC warning C4512: assignment operator could not be generated
+            add_element& operator= (add_element const&);
+        };
+
+        mask_type candidates[end_of_input + 1];
+        mask_type skips;    // the elements skipping whitespace on failure
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  The jump table is built when the alternative is created (if any of
+    //  its elements has a first set) and is never modified afterwards.
+    //  Copies of the alternative share it.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Elements, typename Enable = void>
+    struct shared_first_char_table
+    {
+        shared_first_char_table(Elements const&) {}
+    };
+
+    template <typename Elements>
+    struct shared_first_char_table<Elements
+      , typename enable_if<use_first_char_table<Elements> >::type>
+    {
+        typedef first_char_table<Elements> table_type;
+
+        shared_first_char_table(Elements const& elements)
+          : table(new table_type(elements)) {}
+
+        table_type const& get() const
+        {
+            return *table;
+        }
+
+        shared_ptr<table_type const> table;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  Looks at the next character (after skipping) and decides which of
+    //  the alternatives need to be tried. A bypassed alternative has to
+    //  leave the iterator where it would have after failing, that is behind
+    //  the skipped input for primitive parsers.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Table, typename Iterator, typename Skipper>
+    struct first_char_lookahead
+    {
+        typedef typename Table::mask_type mask_type;
+
+        first_char_lookahead(Table const& table, Iterator& first
+          , Iterator const& last, Skipper const& skipper)
+          : table(table), first(first), last(last), skipper(skipper), bit(1)
+        {
+            update();
+        }
+
+        void update()
+        {
+            start = next = first;
+            qi::skip_over(next, last, skipper);
+            candidates = table.candidates[(next == last) ?
+                Table::end_of_input : static_cast<unsigned char>(*next)];
+        }
+
+        // returns true if the next alternative has to be tried
+        bool advance()
+        {
+            mask_type const current = bit;
+            bit <<= 1;
+
+            if (candidates & current)
+                return true;
+
+            if (table.skips & current)
+                first = next;
+            return false;
+        }
+
+        void failed()
+        {
+            // the alternative moved the iterator without restoring it
+            if (first != start && first != next)
+                update();
+        }
+
+        Table const& table;
+        Iterator& first;
+        Iterator const& last;
+        Skipper const& skipper;
+        Iterator start, next;
+        mask_type candidates;
+        mask_type bit;
+
+    private:
+        // silence MSVC warning C4512: assignment operator could not be generated
+        first_char_lookahead& operator= (first_char_lookahead const&);
+    };
+
+    template <typename Lookahead, typename F>
+    struct first_char_function
+    {
+        first_char_function(Lookahead& lookahead, F& f)
+          : lookahead(lookahead), f(f) {}
+
+        template <typename Component>
+        bool operator()(Component const& component) const
+        {
+            if (!lookahead.advance())
+                return false;
+            if (f(component))
+                return true;
+            lookahead.failed();
+            return false;
+        }
+
+        Lookahead& lookahead;
+        F& f;
+
+    private:
+        // silence MSVC warning C4512: assignment operator could not be generated
+        first_char_function& operator= (first_char_function const&);
+    };
 }}}}
 
 #endif
@@ -0,0 +1,123 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+    Copyright (c) 2001-2011 Hartmut Kaiser
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#if !defined(SPIRIT_FIRST_SET_OCT_16_2026_0930PM)
+#define SPIRIT_FIRST_SET_OCT_16_2026_0930PM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/spirit/home/support/unused.hpp>
+#include <boost/fusion/include/at.hpp>
+#include <boost/fusion/include/value_at.hpp>
+#include <boost/mpl/bool.hpp>
+#include <bitset>
+
+namespace boost { namespace spirit { namespace qi { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  The set of characters a parser component can start its match with,
+    //  used by the alternative parser to skip the alternatives which can't
+    //  match the next character of a char input sequence.
+    //
+    //  first_set<Component>::call(component, chars) adds these characters
+    //  to chars and returns true, or returns false if the component might
+    //  succeed without consuming any input. The component is analyzable
+    //  only if is_known is mpl::true_. skips_on_failure is mpl::true_ if the
+    //  component leaves the iterator behind the skipped input whenever it
+    //  fails (as all primitive parsers do).
+    ///////////////////////////////////////////////////////////////////////////
+    typedef std::bitset<256> char_bitset;
+
+    template <typename Component, typename Enable = void>
+    struct first_set
+    {
+        // by default, a component might start with anything (or nothing)
+        typedef mpl::false_ is_known;
+        typedef mpl::false_ skips_on_failure;
+
+        template <typename T>
+        static bool call(T const&, char_bitset&)
+        {
+            return false;
+        }
+    };
+
+    template <typename Component>
+    struct has_first_set : first_set<Component>::is_known {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    // char parsers match exactly one character: ask them for each of them,
+    // except for the characters they can't answer for in advance (testable
+    // returns false for those), which are assumed to match
+    template <typename Component>
+    struct char_parser_first_set
+    {
+        typedef mpl::true_ is_known;
+        typedef mpl::true_ skips_on_failure;
+
+        static bool testable(Component const&, char)
+        {
+            return true;
+        }
+
+        static bool call(Component const& component, char_bitset& chars)
+        {
+            unused_type context;
+            for (int i = 0; i != 256; ++i)
+            {
+                char const ch = char(i);
+                if (!first_set<Component>::testable(component, ch) ||
+                    component.test(ch, context))
+                {
+                    chars.set(i);
+                }
+            }
+            return true;
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // literal strings start with their first character (the test mirrors
+    // the one in string_parse)
+    template <typename Char>
+    inline bool string_first_set(Char const* str, char_bitset& chars)
+    {
+        if (!*str)
+            return false;
+        for (int i = 0; i != 256; ++i)
+        {
+            if (!(*str != char(i)))
+                chars.set(i);
+        }
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // sequences start with whatever their first element starts with, and
+    // restore the iterator if they fail
+    template <typename Component>
+    struct sequence_first_set
+    {
+        typedef typename
+            fusion::result_of::value_at_c<
+                typename Component::elements_type, 0>::type
+        first_element;
+
+        typedef typename first_set<first_element>::is_known is_known;
+        typedef mpl::false_ skips_on_failure;
+
+        static bool call(Component const& component, char_bitset& chars)
+        {
+            return first_set<first_element>::call(
+                fusion::at_c<0>(component.elements), chars);
+        }
+    };
+}}}}
+
+#endif
@@ -12,6 +12,7 @@
 #endif
 
 #include <boost/spirit/home/qi/nonterminal/rule.hpp>
+#include <boost/spirit/home/qi/nonterminal/static_rule.hpp>
 #include <boost/spirit/home/qi/nonterminal/grammar.hpp>
 #include <boost/spirit/home/qi/nonterminal/error_handler.hpp>
 #include <boost/spirit/home/qi/nonterminal/debug_handler.hpp>
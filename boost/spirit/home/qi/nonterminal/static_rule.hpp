@@ -0,0 +1,323 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#if !defined(BOOST_SPIRIT_STATIC_RULE_OCT_16_2026_0130PM)
+#define BOOST_SPIRIT_STATIC_RULE_OCT_16_2026_0130PM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+
+#include <boost/spirit/home/support/unused.hpp>
+#include <boost/spirit/home/support/info.hpp>
+#include <boost/spirit/home/support/assert_msg.hpp>
+#include <boost/spirit/home/qi/meta_compiler.hpp>
+#include <boost/spirit/home/qi/reference.hpp>
+#include <boost/spirit/home/qi/nonterminal/rule.hpp>
+#include <boost/spirit/home/qi/nonterminal/detail/parameterized.hpp>
+#include <boost/spirit/home/qi/nonterminal/detail/parser_binder.hpp>
+#include <boost/spirit/home/qi/skip_over.hpp>
+
+#if defined(BOOST_MSVC)
+# pragma warning(push)
+# pragma warning(disable: 4355) // 'this' : used in base member initializer list warning
+#endif
+
+namespace boost { namespace spirit { namespace qi
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  static_rule is a rule whose right hand side is part of its type. Expr
+    //  is the type of the (proto) expression the static_rule is initialized
+    //  from. The compiled parser is stored in place of the boost::function
+    //  used by qi::rule, which makes invoking a static_rule (or any
+    //  expression referring to it) a plain, inlinable function call.
+    //
+    //  The attribute, inherited attributes, locals, skipper and encoding
+    //  are specified as for qi::rule (T1 ... T4). Since the right hand side
+    //  has to be known when a static_rule is constructed it can't refer to
+    //  itself; use a qi::rule to break the recursion where needed.
+    ///////////////////////////////////////////////////////////////////////////
+    template <
+        typename Iterator, typename Expr, typename T1 = unused_type
+      , typename T2 = unused_type, typename T3 = unused_type
+      , typename T4 = unused_type>
+    struct static_rule
+      : proto::extends<
+            typename proto::terminal<
+                reference<static_rule<Iterator, Expr, T1, T2, T3, T4> const>
+            >::type
+          , static_rule<Iterator, Expr, T1, T2, T3, T4>
+        >
+      , parser<static_rule<Iterator, Expr, T1, T2, T3, T4> >
+    {
+        typedef Iterator iterator_type;
+        typedef static_rule<Iterator, Expr, T1, T2, T3, T4> this_type;
+        typedef reference<this_type const> reference_;
+        typedef typename proto::terminal<reference_>::type terminal;
+        typedef proto::extends<terminal, this_type> base_type;
+
+        // The equivalent qi::rule, used to extract the rule's properties
+        typedef rule<Iterator, T1, T2, T3, T4> rule_type;
+
+        typedef typename rule_type::locals_type locals_type;
+        typedef typename rule_type::skipper_type skipper_type;
+        typedef typename rule_type::sig_type sig_type;
+        typedef typename rule_type::encoding_type encoding_type;
+        typedef typename rule_type::attr_type attr_type;
+        typedef typename rule_type::parameter_types parameter_types;
+        typedef typename rule_type::context_type context_type;
+        typedef typename rule_type::encoding_modifier_type
+            encoding_modifier_type;
+
+        static size_t const params_size = rule_type::params_size;
+
+        // The right hand side parser, bound as done by the constructor of
+        // qi::rule (the attribute is propagated if there are no semantic
+        // actions).
+        typedef typename
+            result_of::compile<qi::domain, Expr, encoding_modifier_type>::type
+        subject_type;
+        typedef detail::parser_binder<subject_type, mpl::false_> binder_type;
+
+        explicit static_rule(Expr const& expr
+              , std::string const& name_ = "unnamed-rule")
+          : base_type(terminal::make(reference_(*this)))
+          , name_(name_)
+          , binder(compile<qi::domain>(expr, encoding_modifier_type()))
+        {
+            // Report invalid expression error as early as possible.
+            // If you got an error_invalid_expression error message here,
+            // then the expression (expr) is not a valid spirit qi expression.
+            BOOST_SPIRIT_ASSERT_MATCH(qi::domain, Expr);
+        }
+
+        static_rule(static_rule const& rhs)
+          : base_type(terminal::make(reference_(*this)))
+          , name_(rhs.name_)
+          , binder(rhs.binder)
+        {
+        }
+
+        static_rule& operator=(static_rule const& rhs)
+        {
+            binder = rhs.binder;
+            name_ = rhs.name_;
+            return *this;
+        }
+
+        std::string const& name() const
+        {
+            return name_;
+        }
+
+        void name(std::string const& str)
+        {
+            name_ = str;
+        }
+
+        template <typename Context, typename Iterator_>
+        struct attribute
+        {
+            typedef attr_type type;
+        };
+
+        template <typename Context, typename Skipper, typename Attribute>
+        bool parse(Iterator& first, Iterator const& last
+          , Context& /*context*/, Skipper const& skipper
+          , Attribute& attr) const
+        {
+            // If you are seeing a compilation error here, you are probably
+            // trying to use a rule with an incompatible skipper type.
+            BOOST_SPIRIT_ASSERT_MSG(
+                (is_convertible<Skipper const&, skipper_type>::value)
+              , incompatible_skipper_type, (Skipper));
+
+            // do a preskip if this is an implied lexeme
+            if (is_same<skipper_type, unused_type>::value)
+                qi::skip_over(first, last, skipper);
+
+            typedef traits::make_attribute<attr_type, Attribute> make_attribute;
+
+            // do down-stream transformation, provides attribute for
+            // rhs parser
+            typedef traits::transform_attribute<
+                typename make_attribute::type, attr_type, domain>
+            transform;
+
+            typename make_attribute::type made_attr = make_attribute::call(attr);
+            typename transform::type attr_ = transform::pre(made_attr);
+
+            // If you are seeing a compilation error here, you are probably
+            // trying to use a rule which has inherited attributes, without
+            // passing values for them.
+            context_type context(attr_);
+
+            // the right hand side is invoked with the rule's skipper as
+            // done by qi::rule (unused_type makes the rule an implied
+            // lexeme)
+            skipper_type const& rule_skipper = skipper;
+            if (binder(first, last, context, rule_skipper))
+            {
+                // do up-stream transformation, this integrates the results
+                // back into the original attribute value, if appropriate
+                traits::post_transform(attr, attr_);
+                return true;
+            }
+
+            // inform attribute transformation of failed rhs
+            traits::fail_transform(attr, attr_);
+            return false;
+        }
+
+        template <typename Context, typename Skipper
+          , typename Attribute, typename Params>
+        bool parse(Iterator& first, Iterator const& last
+          , Context& caller_context, Skipper const& skipper
+          , Attribute& attr, Params const& params) const
+        {
+            // If you are seeing a compilation error here, you are probably
+            // trying to use a rule with an incompatible skipper type.
+            BOOST_SPIRIT_ASSERT_MSG(
+                (is_convertible<Skipper const&, skipper_type>::value)
+              , incompatible_skipper_type, (Skipper));
+
+            // do a preskip if this is an implied lexeme
+            if (is_same<skipper_type, unused_type>::value)
+                qi::skip_over(first, last, skipper);
+
+            typedef traits::make_attribute<attr_type, Attribute> make_attribute;
+
+            // do down-stream transformation, provides attribute for
+            // rhs parser
+            typedef traits::transform_attribute<
+                typename make_attribute::type, attr_type, domain>
+            transform;
+
+            typename make_attribute::type made_attr = make_attribute::call(attr);
+            typename transform::type attr_ = transform::pre(made_attr);
+
+            // If you are seeing a compilation error here, you are probably
+            // trying to use a rule which has inherited attributes, passing
+            // values of incompatible types for them.
+            context_type context(attr_, params, caller_context);
+
+            // the right hand side is invoked with the rule's skipper as
+            // done by qi::rule (unused_type makes the rule an implied
+            // lexeme)
+            skipper_type const& rule_skipper = skipper;
+            if (binder(first, last, context, rule_skipper))
+            {
+                // do up-stream transformation, this integrates the results
+                // back into the original attribute value, if appropriate
+                traits::post_transform(attr, attr_);
+                return true;
+            }
+
+            // inform attribute transformation of failed rhs
+            traits::fail_transform(attr, attr_);
+            return false;
+        }
+
+        template <typename Context>
+        info what(Context& /*context*/) const
+        {
+            return info(name_);
+        }
+
+        reference_ alias() const
+        {
+            return reference_(*this);
+        }
+
+        // bring in the operator() overloads
+        static_rule const& get_parameterized_subject() const { return *this; }
+        typedef static_rule parameterized_subject_type;
+        #include <boost/spirit/home/qi/nonterminal/detail/fcall.hpp>
+
+        std::string name_;
+        binder_type binder;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  Generator functions for static_rule, deducing the expression type:
+    //
+    //      BOOST_AUTO(r, qi::make_static_rule<Iterator, int()>(expr));
+    //
+    //  or, if your compiler supports it:
+    //
+    //      auto r = qi::make_static_rule<Iterator, int()>(expr);
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Iterator, typename Expr>
+    inline static_rule<Iterator, Expr>
+    make_static_rule(Expr const& expr
+      , std::string const& name = "unnamed-rule")
+    {
+        return static_rule<Iterator, Expr>(expr, name);
+    }
+
+    template <typename Iterator, typename T1, typename Expr>
+    inline static_rule<Iterator, Expr, T1>
+    make_static_rule(Expr const& expr
+      , std::string const& name = "unnamed-rule")
+    {
+        return static_rule<Iterator, Expr, T1>(expr, name);
+    }
+
+    template <typename Iterator, typename T1, typename T2, typename Expr>
+    inline static_rule<Iterator, Expr, T1, T2>
+    make_static_rule(Expr const& expr
+      , std::string const& name = "unnamed-rule")
+    {
+        return static_rule<Iterator, Expr, T1, T2>(expr, name);
+    }
+
+    template <typename Iterator, typename T1, typename T2, typename T3
+      , typename Expr>
+    inline static_rule<Iterator, Expr, T1, T2, T3>
+    make_static_rule(Expr const& expr
+      , std::string const& name = "unnamed-rule")
+    {
+        return static_rule<Iterator, Expr, T1, T2, T3>(expr, name);
+    }
+
+    template <typename Iterator, typename T1, typename T2, typename T3
+      , typename T4, typename Expr>
+    inline static_rule<Iterator, Expr, T1, T2, T3, T4>
+    make_static_rule(Expr const& expr
+      , std::string const& name = "unnamed-rule")
+    {
+        return static_rule<Iterator, Expr, T1, T2, T3, T4>(expr, name);
+    }
+}}}
+
+namespace boost { namespace spirit { namespace traits
+{
+    ///////////////////////////////////////////////////////////////////////////
+    template <
+        typename IteratorA, typename IteratorB, typename Attribute
+      , typename Context, typename Expr, typename T1, typename T2
+      , typename T3, typename T4>
+    struct handles_container<
+        qi::static_rule<IteratorA, Expr, T1, T2, T3, T4>, Attribute, Context
+      , IteratorB>
+      : traits::is_container<
+          typename attribute_of<
+              qi::static_rule<IteratorA, Expr, T1, T2, T3, T4>
+            , Context, IteratorB
+          >::type
+        >
+    {};
+}}}
+
+#if defined(BOOST_MSVC)
+# pragma warning(pop)
+#endif
+
+#endif
@@ -0,0 +1,467 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+    Copyright (c) 2001-2011 Hartmut Kaiser
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#if !defined(SPIRIT_EXACT_REAL_OCT_16_2026_0200PM)
+#define SPIRIT_EXACT_REAL_OCT_16_2026_0200PM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <cfloat>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/detail/iterator.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/spirit/home/qi/numeric/detail/power_of_five.hpp>
+
+//  strtof is a C99 function, which is not necessarily available for C++03.
+//  Without it float is converted using strtod instead, which may round twice
+//  for inputs extremely close to the halfway point between two floats.
+#if !defined(BOOST_SPIRIT_HAS_STRTOF) && !defined(BOOST_SPIRIT_NO_STRTOF)
+#  if defined(__GLIBC__) || defined(__APPLE__) || defined(__FreeBSD__) \
+   || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__MINGW32__) \
+   || (defined(BOOST_MSVC) && BOOST_MSVC >= 1800) \
+   || (defined(_POSIX_VERSION) && _POSIX_VERSION >= 200112L)
+#    define BOOST_SPIRIT_HAS_STRTOF
+#  endif
+#endif
+
+namespace boost { namespace spirit { namespace qi { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  The IEEE 754 binary formats supported by the correctly rounded
+    //  conversion (see ureal_policies::correctly_rounded)
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    struct exact_real_traits;
+
+    template <>
+    struct exact_real_traits<double>
+    {
+        typedef boost::uint64_t bits_type;
+
+        static int const mantissa_bits = 52;
+        static int const minimum_exponent = -1023;
+        static int const infinite_power = 0x7ff;
+        static int const min_round_to_even = -4;
+        static int const max_round_to_even = 23;
+        static int const smallest_power_of_ten = -342;
+        static int const largest_power_of_ten = 308;
+
+        // the range of exact conversions using plain floating point math
+        static int const max_exact_power_of_ten = 22;
+        static boost::uint64_t max_exact_mantissa()
+        {
+            return boost::uint64_t(1) << 53;
+        }
+
+        static double pow10(int exp)
+        {
+            static double const table[] = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21,
+                1e22
+            };
+            return table[exp];
+        }
+
+        static double from_string(char const* str)
+        {
+            return std::strtod(str, 0);
+        }
+    };
+
+    template <>
+    struct exact_real_traits<float>
+    {
+        typedef boost::uint32_t bits_type;
+
+        static int const mantissa_bits = 23;
+        static int const minimum_exponent = -127;
+        static int const infinite_power = 0xff;
+        static int const min_round_to_even = -17;
+        static int const max_round_to_even = 10;
+        static int const smallest_power_of_ten = -65;
+        static int const largest_power_of_ten = 38;
+
+        static int const max_exact_power_of_ten = 10;
+        static boost::uint64_t max_exact_mantissa()
+        {
+            return boost::uint64_t(1) << 24;
+        }
+
+        static float pow10(int exp)
+        {
+            static float const table[] = {
+                1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f,
+                1e10f
+            };
+            return table[exp];
+        }
+
+        static float from_string(char const* str)
+        {
+#if defined(BOOST_SPIRIT_HAS_STRTOF)
+            return ::strtof(str, 0);
+#else
+            return static_cast<float>(std::strtod(str, 0));
+#endif
+        }
+    };
+
+    template <typename T>
+    struct is_exact_real
+      : mpl::bool_<is_same<T, double>::value || is_same<T, float>::value>
+    {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  The correctly_rounded flag is optional for RealPolicies, it defaults
+    //  to false if not defined
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename RealPolicies>
+    struct has_correctly_rounded
+    {
+        template <bool> struct check;
+        template <typename U>
+        static char test(check<U::correctly_rounded>*);
+        template <typename U>
+        static char (&test(...))[2];
+
+        static bool const value = sizeof(test<RealPolicies>(0)) == 1;
+    };
+
+    template <typename RealPolicies
+      , bool HasFlag = has_correctly_rounded<RealPolicies>::value>
+    struct is_correctly_rounded : mpl::false_ {};
+
+    template <typename RealPolicies>
+    struct is_correctly_rounded<RealPolicies, true>
+      : mpl::bool_<RealPolicies::correctly_rounded> {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  Helpers for 64 bit arithmetic
+    ///////////////////////////////////////////////////////////////////////////
+    inline int count_leading_zeros(boost::uint64_t n)
+    {
+        BOOST_ASSERT(n != 0);
+#if defined(__GNUC__)
+        return __builtin_clzll(n);
+#else
+        int count = 0;
+        for (/**/; !(n & (boost::uint64_t(1) << 63)); n <<= 1)
+            ++count;
+        return count;
+#endif
+    }
+
+    // the full 128 bit product of a and b
+    inline void
+    multiply(boost::uint64_t a, boost::uint64_t b
+      , boost::uint64_t& high, boost::uint64_t& low)
+    {
+#if defined(__GNUC__) && defined(__SIZEOF_INT128__)
+        unsigned __int128 const r = (unsigned __int128)a * b;
+        high = boost::uint64_t(r >> 64);
+        low = boost::uint64_t(r);
+#else
+        boost::uint64_t const mask = 0xffffffffULL;
+        boost::uint64_t const a_lo = a & mask, a_hi = a >> 32;
+        boost::uint64_t const b_lo = b & mask, b_hi = b >> 32;
+
+        boost::uint64_t const lo_lo = a_lo * b_lo;
+        boost::uint64_t const hi_lo = a_hi * b_lo;
+        boost::uint64_t const lo_hi = a_lo * b_hi;
+        boost::uint64_t const hi_hi = a_hi * b_hi;
+
+        boost::uint64_t const cross = (lo_lo >> 32) + (hi_lo & mask) + lo_hi;
+        high = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+        low = (cross << 32) | (lo_lo & mask);
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  The Eisel-Lemire algorithm: computes the correctly rounded binary
+    //  mantissa and (biased) exponent of w * 10^q. The 128 bit approximation
+    //  of the power of five is sufficient for any w (see Mushtak and Lemire,
+    //  "Fast Number Parsing Without Fallback").
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    inline void
+    eisel_lemire(boost::uint64_t w, int q
+      , boost::uint64_t& mantissa, int& power2)
+    {
+        typedef exact_real_traits<T> traits;
+
+        if (w == 0 || q < traits::smallest_power_of_ten)
+        {
+            mantissa = 0;
+            power2 = 0;
+            return;
+        }
+        if (q > traits::largest_power_of_ten)
+        {
+            mantissa = 0;
+            power2 = traits::infinite_power;
+            return;
+        }
+
+        int const lz = count_leading_zeros(w);
+        w <<= lz;
+
+        // the product of w and the power of five, as far as needed
+        boost::uint64_t const* const power = power_of_five_128(q);
+        boost::uint64_t high, low;
+        multiply(w, power[0], high, low);
+
+        boost::uint64_t const precision_mask =
+            ~boost::uint64_t(0) >> (traits::mantissa_bits + 3);
+        if ((high & precision_mask) == precision_mask)
+        {
+            boost::uint64_t high2, low2;
+            multiply(w, power[1], high2, low2);
+            low += high2;
+            if (high2 > low)
+                ++high;
+        }
+
+        int const upperbit = int(high >> 63);
+        int const shift = upperbit + 64 - traits::mantissa_bits - 3;
+        mantissa = high >> shift;
+
+        // floor(log2(10^q)) + 63, see the paper
+        power2 = (((152170 + 65536) * q) >> 16) + 63 + upperbit - lz
+            - traits::minimum_exponent;
+
+        if (power2 <= 0)
+        {
+            // a subnormal number (or zero)
+            if (-power2 + 1 >= 64)
+            {
+                mantissa = 0;
+                power2 = 0;
+                return;
+            }
+            mantissa >>= -power2 + 1;
+            mantissa += (mantissa & 1);
+            mantissa >>= 1;
+            power2 =
+                (mantissa < (boost::uint64_t(1) << traits::mantissa_bits)) ? 0 : 1;
+            return;
+        }
+
+        // exactly half way between two representable numbers: round to even
+        if (low <= 1 && q >= traits::min_round_to_even
+         && q <= traits::max_round_to_even && (mantissa & 3) == 1
+         && (mantissa << shift) == high)
+        {
+            mantissa &= ~boost::uint64_t(1);
+        }
+
+        mantissa += (mantissa & 1);
+        mantissa >>= 1;
+        if (mantissa >= (boost::uint64_t(2) << traits::mantissa_bits))
+        {
+            mantissa = boost::uint64_t(1) << traits::mantissa_bits;
+            ++power2;
+        }
+        mantissa &= ~(boost::uint64_t(1) << traits::mantissa_bits);
+
+        if (power2 >= traits::infinite_power)
+        {
+            mantissa = 0;
+            power2 = traits::infinite_power;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  Convert w * 10^q to T. If truncated is set, w holds the leading digits
+    //  of a longer mantissa only. Returns false if the result can't be
+    //  determined from these digits.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    inline bool
+    exact_real_convert(boost::uint64_t w, int q, bool truncated, T& result)
+    {
+        typedef exact_real_traits<T> traits;
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+        // both w and 10^|q| are exactly representable, a single (correctly
+        // rounded) floating point operation gives the result
+        if (!truncated && w <= traits::max_exact_mantissa()
+         && q >= -traits::max_exact_power_of_ten
+         && q <= traits::max_exact_power_of_ten)
+        {
+            result = T(w);
+            if (q < 0)
+                result /= traits::pow10(-q);
+            else
+                result *= traits::pow10(q);
+            return true;
+        }
+#endif
+
+        boost::uint64_t mantissa;
+        int power2;
+        eisel_lemire<T>(w, q, mantissa, power2);
+
+        // the exact mantissa lies between w and w + 1, both have to give
+        // the same result
+        if (truncated)
+        {
+            boost::uint64_t mantissa_next;
+            int power2_next;
+            eisel_lemire<T>(w + 1, q, mantissa_next, power2_next);
+            if (mantissa != mantissa_next || power2 != power2_next)
+                return false;
+        }
+
+        typename traits::bits_type const bits =
+            typename traits::bits_type(mantissa
+              | (boost::uint64_t(power2) << traits::mantissa_bits));
+        std::memcpy(&result, &bits, sizeof(result));
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  decimal_mantissa: collects the digits of a real number as an integer
+    //  of up to 19 significant digits and a decimal exponent. The digits
+    //  beyond are kept separately, for the rare cases needing them.
+    ///////////////////////////////////////////////////////////////////////////
+    struct decimal_mantissa
+    {
+        static int const max_digits = 19;
+        static int const max_exponent = 100000;
+
+        decimal_mantissa()
+          : value(0), digits(0), exponent(0), truncated(false) {}
+
+        // parse the digits of the integer part, returns false if there are
+        // none
+        template <typename Iterator>
+        bool parse_integer(Iterator& first, Iterator const& last)
+        {
+            return parse(first, last, false);
+        }
+
+        // parse the digits of the fractional part, returns false if there
+        // are none
+        template <typename Iterator>
+        bool parse_fraction(Iterator& first, Iterator const& last)
+        {
+            return parse(first, last, true);
+        }
+
+        void scale(int exp)
+        {
+            // anything beyond is zero or infinity anyway
+            if (exp > max_exponent)
+                exp = max_exponent;
+            else if (exp < -max_exponent)
+                exp = -max_exponent;
+            exponent += exp;
+        }
+
+        bool is_equal_to_one() const
+        {
+            return value == 1 && exponent == 0 && tail.empty();
+        }
+
+        template <typename T>
+        T convert() const
+        {
+            T result;
+            if (exact_real_convert(value, exponent, truncated, result))
+                return result;
+
+            // all digits are needed to decide the rounding
+            char buffer[max_digits + 1];
+            char* p = buffer + max_digits;
+            *p = '\0';
+            for (boost::uint64_t n = value; n != 0; n /= 10)
+                *--p = char('0' + n % 10);
+
+            std::string str(p);
+            str += tail;
+            str += 'e';
+
+            int exp = exponent - static_cast<int>(tail.size());
+            if (exp < 0)
+            {
+                str += '-';
+                exp = -exp;
+            }
+            std::size_t const pos = str.size();
+            do
+            {
+                str.insert(pos, 1, char('0' + exp % 10));
+                exp /= 10;
+            } while (exp != 0);
+
+            return exact_real_traits<T>::from_string(str.c_str());
+        }
+
+    private:
+        template <typename Iterator>
+        bool parse(Iterator& first, Iterator const& last, bool fraction)
+        {
+            Iterator it = first;
+            bool got_digit = false;
+            for (/**/; it != last; ++it)
+            {
+                typename boost::detail::iterator_traits<Iterator>::value_type
+                    ch = *it;
+                if (ch < '0' || ch > '9')
+                    break;
+
+                add(static_cast<unsigned>(ch - '0'), fraction);
+                got_digit = true;
+            }
+
+            if (!got_digit)
+                return false;
+            first = it;
+            return true;
+        }
+
+        void add(unsigned digit, bool fraction)
+        {
+            if (digits < max_digits)
+            {
+                if (fraction)
+                    --exponent;
+
+                // leading zeros are not significant
+                if (value == 0 && digit == 0)
+                    return;
+
+                value = value * 10 + digit;
+                ++digits;
+            }
+            else
+            {
+                if (!fraction)
+                    ++exponent;
+                if (digit != 0)
+                    truncated = true;
+                tail += char('0' + digit);
+            }
+        }
+
+        boost::uint64_t value;
+        int digits;
+        int exponent;
+        bool truncated;
+        std::string tail;
+    };
+}}}}
+
+#endif
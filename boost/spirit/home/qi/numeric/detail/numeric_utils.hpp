@@ -20,10 +20,13 @@
 #include <boost/preprocessor/repetition/repeat.hpp>
 #include <boost/utility/enable_if.hpp>
 #include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <boost/type_traits/is_signed.hpp>
 #include <boost/mpl/bool.hpp>
 #include <boost/mpl/and.hpp>
+#include <boost/cstdint.hpp>
 
+#include <algorithm>
 #include <limits>
 #include <boost/limits.hpp>
 
@@ -189,6 +192,12 @@ namespace boost { namespace spirit { namespace qi { namespace detail
             n += static_cast<T>(digit);
             return true;
         }
+
+        template <typename T>
+        inline static void add_digits(T& n, T scale, T value) // unchecked
+        {
+            n = n * scale + value;
+        }
     };
 
     template <unsigned Radix>
@@ -220,6 +229,12 @@ namespace boost { namespace spirit { namespace qi { namespace detail
             n -= static_cast<T>(digit);
             return true;
         }
+
+        template <typename T>
+        inline static void add_digits(T& n, T scale, T value) // unchecked
+        {
+            n = n * scale - value;
+        }
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -263,6 +278,11 @@ namespace boost { namespace spirit { namespace qi { namespace detail
             return true;
         }
 
+        // Overflow is checked for all bounded integer types. Signed
+        // integers are not is_modulo (for many standard libraries), but
+        // overflow of signed integers has to be detected as well. Floating
+        // point types are bounded too, but they saturate to infinity (the
+        // real parser relies on this for long mantissas).
         template <typename Char, typename T>
         inline static bool
         call(Char ch, std::size_t count, T& n)
@@ -272,12 +292,132 @@ namespace boost { namespace spirit { namespace qi { namespace detail
                     (   (MaxDigits < 0)
                     ||  (MaxDigits > radix_traits<Radix>::template digits<T>::value)
                     )
-                  && std::numeric_limits<T>::is_modulo
+                  && std::numeric_limits<T>::is_integer
+                  && std::numeric_limits<T>::is_bounded
                 >()
             );
         }
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    //  block_extractor: converts up to eight decimal digits at once from
+    //  contiguous char input by loading them into a single 64 bit word (SWAR,
+    //  SIMD within a register). Blocks are consumed only as long as the result
+    //  can't overflow, everything else (including the digits close to the
+    //  overflow boundary) is left to the checked, per digit loop. Define
+    //  SPIRIT_NUMERICS_NO_SWAR to disable it.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Iterator, typename T, unsigned Radix, bool Accumulate>
+    struct use_block_extractor
+      : mpl::bool_<
+            Radix == 10 && !Accumulate
+         && is_integral<T>::value && !is_same<T, bool>::value
+         && sizeof(T) <= sizeof(boost::uint64_t)
+         && (is_same<Iterator, char const*>::value
+          || is_same<Iterator, char*>::value)>
+    {};
+
+    template <typename Accumulator, bool Enable>
+    struct block_extractor
+    {
+        template <typename Iterator, typename T>
+        inline static bool
+        call(Iterator& /*it*/, Iterator const& /*last*/, T& /*n*/
+          , std::size_t& /*digits*/)
+        {
+            return false;
+        }
+    };
+
+    template <typename Accumulator>
+    struct block_extractor<Accumulator, true>
+    {
+        // Adds the digits at 'it' to n (which holds 'digits' digits). Returns
+        // true if the number ended, false if the remaining digits (if any)
+        // need to be converted by the caller.
+        template <typename Iterator, typename T>
+        inline static bool
+        call(Iterator& it, Iterator const& last, T& n, std::size_t& digits)
+        {
+            static std::size_t const max_digits =
+                radix_traits<10>::template digits<T>::value;
+            static boost::uint32_t const scale[] = {
+                1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+            };
+
+            while (last - it >= 8)
+            {
+                boost::uint64_t const block = load(it);
+                std::size_t const found = leading_digits(block);
+                std::size_t const taken = (std::min)(found, max_digits - digits);
+                if (taken == 0)
+                    return found == 0 && digits != 0;
+
+                Accumulator::add_digits(n, T(scale[taken])
+                  , T(convert(block, taken)));
+                it += taken;
+                digits += taken;
+                if (taken != 8)
+                    return taken == found;
+            }
+            return false;
+        }
+
+        // the first character ends up in the lowest byte, independent of
+        // the endianness of the platform
+        template <typename Iterator>
+        inline static boost::uint64_t load(Iterator it)
+        {
+            // most compilers turn this into a single load
+            typedef unsigned char uchar;
+            return boost::uint64_t(uchar(it[0]))
+                | (boost::uint64_t(uchar(it[1])) << 8)
+                | (boost::uint64_t(uchar(it[2])) << 16)
+                | (boost::uint64_t(uchar(it[3])) << 24)
+                | (boost::uint64_t(uchar(it[4])) << 32)
+                | (boost::uint64_t(uchar(it[5])) << 40)
+                | (boost::uint64_t(uchar(it[6])) << 48)
+                | (boost::uint64_t(uchar(it[7])) << 56);
+        }
+
+        // number of decimal digits at the start of the block
+        inline static std::size_t leading_digits(boost::uint64_t block)
+        {
+            boost::uint64_t const high = 0xf0f0f0f0f0f0f0f0ULL;
+            boost::uint64_t const zeros = 0x3030303030303030ULL;
+
+            // non zero bytes mark characters not in ['0', '9'], carries only
+            // propagate into the bytes following such a character
+            boost::uint64_t mask = ((block & high) ^ zeros)
+              | (((block + 0x0606060606060606ULL) & high) ^ zeros);
+            if (mask == 0)
+                return 8;
+
+#if defined(__GNUC__)
+            return __builtin_ctzll(mask) / 8;
+#else
+            std::size_t digits = 0;
+            for (/**/; (mask & 0xff) == 0; mask >>= 8)
+                ++digits;
+            return digits;
+#endif
+        }
+
+        // convert the first digits (1 to 8) of the block
+        inline static boost::uint32_t
+        convert(boost::uint64_t block, std::size_t digits)
+        {
+            // shift out the trailing characters, the vacated bytes act as
+            // leading zeros
+            block <<= 8 * (8 - digits);
+
+            block = ((block & 0x0f0f0f0f0f0f0f0fULL) * 2561) >> 8;
+            block = ((block & 0x00ff00ff00ff00ffULL) * 6553601) >> 16;
+            return boost::uint32_t(
+                ((block & 0x0000ffff0000ffffULL) * 42949672960001ULL) >> 32);
+        }
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     //  End of loop checking: check if the number of digits
     //  being parsed exceeds MaxDigits. Note: if MaxDigits == -1
@@ -465,19 +605,38 @@ namespace boost { namespace spirit { namespace qi { namespace detail
             attribute_type;
 
             attribute_type val = Accumulate ? attr : attribute_type(0);
-            char_type ch = *it;
+            std::size_t digits = 0;
+            char_type ch;
 
-            if (!radix_check::is_valid(ch) || !extractor::call(ch, 0, val))
+#if !defined(SPIRIT_NUMERICS_NO_SWAR)
+            if (block_extractor<Accumulator
+                  , use_block_extractor<
+                        Iterator, attribute_type, Radix, Accumulate>::value
+                >::call(it, last, val, digits))
             {
-                if (count == 0) // must have at least one digit
-                    return false;
                 traits::assign_to(val, attr);
                 first = it;
                 return true;
             }
+#endif
+
+            if (digits == 0)
+            {
+                ch = *it;
+                if (!radix_check::is_valid(ch) || !extractor::call(ch, 0, val))
+                {
+                    if (count == 0) // must have at least one digit
+                        return false;
+                    traits::assign_to(val, attr);
+                    first = it;
+                    return true;
+                }
+                ++it;
+                digits = 1;
+            }
+
+            count = digits - 1;
 
-            count = 0;
-            ++it;
             while (true)
             {
                 BOOST_PP_REPEAT(
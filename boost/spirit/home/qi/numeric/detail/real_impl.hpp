@@ -20,6 +20,8 @@
 #include <boost/spirit/home/qi/detail/attributes.hpp>
 #include <boost/spirit/home/support/detail/pow10.hpp>
 #include <boost/spirit/home/support/detail/sign.hpp>
+#include <boost/spirit/home/qi/numeric/detail/exact_real.hpp>
+#include <boost/mpl/bool.hpp>
 #include <boost/assert.hpp>
 
 #if BOOST_WORKAROUND(BOOST_MSVC, >= 1400)
@@ -132,6 +134,18 @@ namespace boost { namespace spirit { namespace qi  { namespace detail
         static bool
         parse(Iterator& first, Iterator const& last, Attribute& attr,
             RealPolicies const& p)
+        {
+            return parse(first, last, attr, p
+              , mpl::bool_<
+                    is_correctly_rounded<RealPolicies>::value &&
+                    is_exact_real<T>::value
+                >());
+        }
+
+        template <typename Iterator, typename Attribute>
+        static bool
+        parse(Iterator& first, Iterator const& last, Attribute& attr,
+            RealPolicies const& p, mpl::false_)
         {
             if (first == last)
                 return false;
@@ -260,6 +274,95 @@ namespace boost { namespace spirit { namespace qi  { namespace detail
             // Success!!!
             return true;
         }
+
+        // The correctly rounded conversion collects the digits as an integer
+        // (see decimal_mantissa) instead of using the parse_n and
+        // parse_frac_n policies, the remaining policies are applied as above.
+        template <typename Iterator, typename Attribute>
+        static bool
+        parse(Iterator& first, Iterator const& last, Attribute& attr,
+            RealPolicies const& p, mpl::true_)
+        {
+            if (first == last)
+                return false;
+            Iterator save = first;
+
+            bool neg = p.parse_sign(first, last);
+
+            T n = 0;
+            decimal_mantissa mantissa;
+            bool got_a_number = mantissa.parse_integer(first, last);
+
+            if (!got_a_number)
+            {
+                if (p.parse_nan(first, last, n) ||
+                    p.parse_inf(first, last, n))
+                {
+                    traits::assign_to(traits::negate(neg, n), attr);
+                    return true;
+                }
+
+                if (!p.allow_leading_dot)
+                {
+                    first = save;
+                    return false;
+                }
+            }
+
+            bool e_hit = false;
+            bool got_a_fraction = false;
+
+            if (p.parse_dot(first, last))
+            {
+                got_a_fraction = mantissa.parse_fraction(first, last);
+                if (!got_a_fraction && (!got_a_number || !p.allow_trailing_dot))
+                {
+                    first = save;
+                    return false;
+                }
+                e_hit = p.parse_exp(first, last);
+            }
+            else
+            {
+                if (!got_a_number)
+                {
+                    first = save;
+                    return false;
+                }
+
+                e_hit = p.parse_exp(first, last);
+                if (p.expect_dot && !e_hit)
+                {
+                    first = save;
+                    return false;
+                }
+            }
+
+            if (e_hit)
+            {
+                int exp = 0;
+                if (!p.parse_exp_n(first, last, exp))
+                {
+                    first = save;
+                    return false;
+                }
+                mantissa.scale(exp);
+            }
+            else if (!got_a_fraction && mantissa.is_equal_to_one())
+            {
+                // check for the 1.0#... styles of NaN or Inf
+                if (p.parse_nan(first, last, n) ||
+                    p.parse_inf(first, last, n))
+                {
+                    traits::assign_to(traits::negate(neg, n), attr);
+                    return true;
+                }
+            }
+
+            n = mantissa.template convert<T>();
+            traits::assign_to(traits::negate(neg, n), attr);
+            return true;
+        }
     };
 
 #if BOOST_WORKAROUND(BOOST_MSVC, >= 1400)
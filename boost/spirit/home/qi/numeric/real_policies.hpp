@@ -28,6 +28,11 @@ namespace boost { namespace spirit { namespace qi
         static bool const allow_trailing_dot = true;
         static bool const expect_dot = false;
 
+        // If set, float and double are converted correctly rounded (and
+        // much faster, see detail/exact_real.hpp). The parse_n and
+        // parse_frac_n functions below are not used in this case.
+        static bool const correctly_rounded = false;
+
         template <typename Iterator>
         static bool
         parse_sign(Iterator& /*first*/, Iterator const& /*last*/)
@@ -181,6 +186,18 @@ namespace boost { namespace spirit { namespace qi
     {
         static bool const expect_dot = true;
     };
+
+    template <typename T>
+    struct exact_ureal_policies : ureal_policies<T>
+    {
+        static bool const correctly_rounded = true;
+    };
+
+    template <typename T>
+    struct exact_real_policies : real_policies<T>
+    {
+        static bool const correctly_rounded = true;
+    };
 }}}
 
 #endif
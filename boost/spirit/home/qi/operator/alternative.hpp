@@ -64,7 +64,29 @@ namespace boost { namespace spirit { namespace qi
         };
 
         alternative(Elements const& elements)
-          : elements(elements) {}
+          : elements(elements), first_chars(elements) {}
+
+        template <typename Iterator, typename Skipper, typename F>
+        bool parse_impl(Iterator& /*first*/, Iterator const& /*last*/
+          , Skipper const& /*skipper*/, F& f, mpl::false_) const
+        {
+            // return true if *any* of the parsers succeed
+            return fusion::any(elements, f);
+        }
+
+        template <typename Iterator, typename Skipper, typename F>
+        bool parse_impl(Iterator& first, Iterator const& last
+          , Skipper const& skipper, F& f, mpl::true_) const
+        {
+            typedef detail::first_char_lookahead<
+                detail::first_char_table<Elements>, Iterator, Skipper>
+            lookahead_type;
+
+            // try only the parsers which can start with the next character
+            lookahead_type lookahead(first_chars.get(), first, last, skipper);
+            return fusion::any(elements
+              , detail::first_char_function<lookahead_type, F>(lookahead, f));
+        }
 
         template <typename Iterator, typename Context
           , typename Skipper, typename Attribute>
@@ -75,8 +97,8 @@ namespace boost { namespace spirit { namespace qi
             detail::alternative_function<Iterator, Context, Skipper, Attribute>
                 f(first, last, context, skipper, attr);
 
-            // return true if *any* of the parsers succeed
-            return fusion::any(elements, f);
+            return parse_impl(first, last, skipper, f
+              , detail::use_first_char_dispatch<Elements, Iterator>());
         }
 
         template <typename Context>
@@ -89,6 +111,7 @@ namespace boost { namespace spirit { namespace qi
         }
 
         Elements elements;
+        detail::shared_first_char_table<Elements> first_chars;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -12,6 +12,7 @@
 #endif
 
 #include <boost/spirit/home/qi/operator/sequence_base.hpp>
+#include <boost/spirit/home/qi/detail/first_set.hpp>
 #include <boost/spirit/home/qi/detail/expect_function.hpp>
 #include <boost/spirit/home/qi/meta_compiler.hpp>
 #include <boost/spirit/home/support/has_semantic_action.hpp>
@@ -84,6 +85,14 @@ namespace boost { namespace spirit { namespace qi
     {};
 }}}
 
+namespace boost { namespace spirit { namespace qi { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Elements>
+    struct first_set<expect<Elements> >
+      : sequence_first_set<expect<Elements> > {};
+}}}}
+
 namespace boost { namespace spirit { namespace traits
 {
     ///////////////////////////////////////////////////////////////////////////
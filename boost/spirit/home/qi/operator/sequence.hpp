@@ -12,6 +12,7 @@
 #endif
 
 #include <boost/spirit/home/qi/operator/sequence_base.hpp>
+#include <boost/spirit/home/qi/detail/first_set.hpp>
 #include <boost/spirit/home/qi/detail/fail_function.hpp>
 #include <boost/spirit/home/qi/meta_compiler.hpp>
 
@@ -77,6 +78,14 @@ namespace boost { namespace spirit { namespace qi
 //     {};
 }}}
 
+namespace boost { namespace spirit { namespace qi { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Elements>
+    struct first_set<sequence<Elements> >
+      : sequence_first_set<sequence<Elements> > {};
+}}}}
+
 namespace boost { namespace spirit { namespace traits
 {
     ///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,335 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#if !defined(BOOST_SPIRIT_FLAT_TST_OCT_16_2026_1045AM)
+#define BOOST_SPIRIT_FLAT_TST_OCT_16_2026_1045AM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/spirit/home/qi/string/tst.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace boost { namespace spirit { namespace qi
+{
+    namespace detail
+    {
+        // A node of the flattened TST. The children are indexes into the
+        // node array, 0 (the root) is never a child and is used as the
+        // null link. 'end' is set if an entry ends at the node, so that
+        // the entry array is only looked at for these nodes ('end' fits
+        // into the padding after a narrow 'id').
+        template <typename Char>
+        struct flat_tst_node
+        {
+            Char id;
+            bool end;
+            boost::uint32_t lt;
+            boost::uint32_t eq;
+            boost::uint32_t gt;
+        };
+
+        template <typename Char, typename T>
+        struct flat_tst_collect
+        {
+            typedef std::vector<std::pair<std::basic_string<Char>, T*> >
+                entries_type;
+
+            flat_tst_collect(entries_type& entries)
+              : entries(entries) {}
+
+            void operator()(std::basic_string<Char> const& s, T& data) const
+            {
+                entries.push_back(std::make_pair(s, &data));
+            }
+
+            entries_type& entries;
+
+        private:
+            // silence MSVC warning C4512: assignment operator could not be generated
+            flat_tst_collect& operator= (flat_tst_collect const&);
+        };
+
+        template <typename Char, typename T>
+        struct flat_tst_less
+        {
+            typedef std::pair<std::basic_string<Char>, T*> entry_type;
+
+            // compare the characters the same way as find() does (and not
+            // using the char_traits, which compare char as unsigned)
+            bool operator()(entry_type const& lhs, entry_type const& rhs) const
+            {
+                return std::lexicographical_compare(
+                    lhs.first.begin(), lhs.first.end()
+                  , rhs.first.begin(), rhs.first.end());
+            }
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  flat_tst is a symbols lookup (see tst) which can be frozen. freeze()
+    //  compiles all entries into a balanced ternary search tree stored
+    //  depth first in a single array, using 32 bit child indexes instead
+    //  of pointers. Lookups in a frozen flat_tst touch far fewer cache lines
+    //  than the node based tst. Adding new entries or removing entries 
+    //  thaws the flat_tst (lookups fall back to the node based tst) until 
+    //  freeze() is called again.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Char, typename T>
+    struct flat_tst
+    {
+        typedef Char char_type; // the character type
+        typedef T value_type; // the value associated with each entry
+        typedef detail::flat_tst_node<Char> node;
+
+        flat_tst()
+        {
+        }
+
+        flat_tst(flat_tst const& rhs)
+          : tree(rhs.tree)
+        {
+            if (rhs.frozen())
+                freeze();
+        }
+
+        flat_tst& operator=(flat_tst const& rhs)
+        {
+            if (this != &rhs)
+            {
+                thaw();
+                tree = rhs.tree;
+                if (rhs.frozen())
+                    freeze();
+            }
+            return *this;
+        }
+
+        template <typename Iterator, typename Filter>
+        T* find(Iterator& first, Iterator last, Filter filter) const
+        {
+            if (nodes.empty())
+                return tree.find(first, last, filter);
+
+            if (first == last)
+                return 0;
+
+            Iterator i = first;
+            Iterator latest = first;
+            node const* base = &nodes.front();
+            T* const* values = &data.front();
+            boost::uint32_t p = 0;
+            T* found = 0;
+
+            for (;;)
+            {
+                typename
+                    boost::detail::iterator_traits<Iterator>::value_type
+                c = filter(*i); // filter only the input
+                node const& n = base[p];
+
+                if (c == n.id)
+                {
+                    if (n.end)
+                    {
+                        found = values[p];
+                        latest = i;
+                    }
+                    p = n.eq;
+                    if (p == 0 || ++i == last)
+                        break;
+                }
+                else
+                {
+                    p = (c < n.id) ? n.lt : n.gt;
+                    if (p == 0)
+                        break;
+                }
+            }
+
+            if (found)
+                first = ++latest; // one past the last matching char
+            return found;
+        }
+
+        template <typename Iterator>
+        T* find(Iterator& first, Iterator last) const
+        {
+            return find(first, last, tst_pass_through());
+        }
+
+        template <typename Iterator>
+        T* add(
+            Iterator first
+          , Iterator last
+          , typename boost::call_traits<T>::param_type val)
+        {
+            // an existing entry is returned without thawing
+            if (T* p = find_entry(first, last))
+                return p;
+
+            thaw();
+            return tree.add(first, last, val);
+        }
+
+        template <typename Iterator>
+        void remove(Iterator first, Iterator last)
+        {
+            if (find_entry(first, last))
+            {
+                thaw();
+                tree.remove(first, last);
+            }
+        }
+
+        void clear()
+        {
+            thaw();
+            tree.clear();
+        }
+
+        template <typename F>
+        void for_each(F f) const
+        {
+            tree.for_each(f);
+        }
+
+        // build the flat representation of all current entries
+        void freeze()
+        {
+            typedef detail::flat_tst_collect<Char, T> collect_type;
+            typename collect_type::entries_type entries;
+
+            thaw();
+            tree.for_each(collect_type(entries));
+            if (entries.empty())
+                return;
+
+            std::sort(entries.begin(), entries.end()
+              , detail::flat_tst_less<Char, T>());
+
+            // Every work item describes a node to create: the entries
+            // [first, last), all sharing the first 'depth' characters and
+            // all longer than that, and the link of the parent node to
+            // patch. Processing them in LIFO order, with the eq link pushed
+            // last, stores every eq child right after its parent, so that
+            // matching characters mostly stay within the same cache line.
+            std::vector<work_item> work;
+            work.push_back(work_item(0, entries.size(), 0));
+
+            while (!work.empty())
+            {
+                work_item item = work.back();
+                work.pop_back();
+
+                // split the entries into groups by their character at
+                // 'depth', the median group becomes the new node
+                std::vector<std::size_t> groups;
+                for (std::size_t i = item.first; i != item.last; ++i)
+                {
+                    if (i == item.first || entries[i].first[item.depth] !=
+                        entries[i-1].first[item.depth])
+                    {
+                        groups.push_back(i);
+                    }
+                }
+                groups.push_back(item.last);
+
+                std::size_t const count = groups.size() - 1;
+                std::size_t const median = count / 2;
+                std::size_t first = groups[median];
+                std::size_t const last = groups[median + 1];
+
+                BOOST_ASSERT(nodes.size() < 0xffffffffu);
+                boost::uint32_t const index =
+                    static_cast<boost::uint32_t>(nodes.size());
+                node n;
+                n.id = entries[first].first[item.depth];
+                n.end = false;
+                n.lt = n.eq = n.gt = 0;
+                nodes.push_back(n);
+                data.push_back(0);
+
+                if (item.link)
+                    nodes[item.parent].*item.link = index;
+
+                // the sorted entries are unique, so at most the first one
+                // ends with this character
+                if (entries[first].first.size() == item.depth + 1)
+                {
+                    nodes.back().end = true;
+                    data.back() = entries[first++].second;
+                }
+
+                if (median + 1 != count)
+                {
+                    work.push_back(work_item(last, item.last
+                      , item.depth, &node::gt, index));
+                }
+                if (median != 0)
+                {
+                    work.push_back(work_item(item.first, groups[median]
+                      , item.depth, &node::lt, index));
+                }
+                if (first != last)
+                {
+                    work.push_back(work_item(first, last, item.depth + 1
+                      , &node::eq, index));
+                }
+            }
+        }
+
+        // drop the flat representation
+        void thaw()
+        {
+            std::vector<node>().swap(nodes);
+            std::vector<T*>().swap(data);
+        }
+
+        bool frozen() const
+        {
+            return !nodes.empty();
+        }
+
+    private:
+        // the entry matching all of [first, last), if any
+        template <typename Iterator>
+        T* find_entry(Iterator first, Iterator last) const
+        {
+            Iterator i = first;
+            T* p = find(i, last);
+            return (p && i == last) ? p : 0;
+        }
+
+        typedef boost::uint32_t node::* link_type;
+
+        struct work_item
+        {
+            work_item(std::size_t first, std::size_t last, std::size_t depth
+                  , link_type link = 0, boost::uint32_t parent = 0)
+              : first(first), last(last), depth(depth)
+              , link(link), parent(parent) {}
+
+            std::size_t first;
+            std::size_t last;
+            std::size_t depth;
+            link_type link;         // the link of the parent to patch
+            boost::uint32_t parent;
+        };
+
+        tst<Char, T> tree;          // owns the entries
+        std::vector<node> nodes;    // the frozen tree, root first
+        std::vector<T*> data;       // the entry of each node (if any)
+    };
+}}}
+
+#endif
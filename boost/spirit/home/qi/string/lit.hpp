@@ -16,6 +16,7 @@
 #include <boost/spirit/home/qi/domain.hpp>
 #include <boost/spirit/home/qi/skip_over.hpp>
 #include <boost/spirit/home/qi/detail/string_parse.hpp>
+#include <boost/spirit/home/qi/detail/first_set.hpp>
 #include <boost/spirit/home/qi/parser.hpp>
 #include <boost/spirit/home/qi/meta_compiler.hpp>
 #include <boost/spirit/home/qi/auxiliary/lazy.hpp>
@@ -291,6 +292,39 @@ namespace boost { namespace spirit { namespace qi
     };
 }}}
 
+namespace boost { namespace spirit { namespace qi { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename String, bool no_attribute>
+    struct first_set<literal_string<String, no_attribute> >
+    {
+        typedef mpl::true_ is_known;
+        typedef mpl::true_ skips_on_failure;
+
+        static bool call(literal_string<String, no_attribute> const& component
+          , char_bitset& chars)
+        {
+            return string_first_set(
+                traits::get_c_string(component.str), chars);
+        }
+    };
+
+    template <typename String, bool no_attribute>
+    struct first_set<no_case_literal_string<String, no_attribute> >
+    {
+        typedef mpl::true_ is_known;
+        typedef mpl::true_ skips_on_failure;
+
+        static bool
+        call(no_case_literal_string<String, no_attribute> const& component
+          , char_bitset& chars)
+        {
+            return string_first_set(component.str_lo.c_str(), chars) &&
+                string_first_set(component.str_hi.c_str(), chars);
+        }
+    };
+}}}}
+
 namespace boost { namespace spirit { namespace traits
 {
     ///////////////////////////////////////////////////////////////////////////
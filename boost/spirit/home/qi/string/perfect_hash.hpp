@@ -0,0 +1,609 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#if !defined(BOOST_SPIRIT_PERFECT_HASH_OCT_16_2026_1130AM)
+#define BOOST_SPIRIT_PERFECT_HASH_OCT_16_2026_1130AM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/spirit/home/qi/string/tst.hpp>
+#include <boost/call_traits.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/detail/iterator.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
+#include <algorithm>
+#include <climits>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+#if !defined(BOOST_SPIRIT_QI_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BOOST_SPIRIT_QI_SSE2
+#include <emmintrin.h>
+#endif
+#endif
+
+namespace boost { namespace spirit { namespace qi
+{
+    namespace detail
+    {
+        // A minimal perfect hash table of (packed) key prefixes, every slot
+        // refers to the candidates (the entries) having that prefix.
+        template <typename Char, typename T>
+        struct perfect_hash_table
+        {
+            struct slot
+            {
+                boost::uint64_t key;
+                boost::uint32_t first;  // the candidates [first, last)
+                boost::uint32_t last;
+            };
+
+            boost::uint64_t seed;
+            std::vector<boost::uint32_t> displacements;
+            std::vector<slot> slots;
+        };
+
+        template <typename Char, typename T>
+        struct perfect_hash_candidate
+        {
+            boost::uint32_t offset;     // the characters of the entry
+            boost::uint32_t length;
+            T* data;
+        };
+
+        template <typename Char, typename T>
+        struct perfect_hash_longer
+        {
+            typedef perfect_hash_candidate<Char, T> candidate;
+
+            bool operator()(candidate const& lhs, candidate const& rhs) const
+            {
+                return lhs.length > rhs.length;
+            }
+        };
+
+        template <typename Char>
+        struct perfect_hash_traits
+        {
+            static std::size_t const bits = sizeof(Char) * CHAR_BIT;
+
+            // the number of characters packed into a 64 bit key
+            static std::size_t const max_prefix = bits < 64 ? 64 / bits : 1;
+
+            // a set of (the lower 8 bits of) characters
+            static void set(boost::uint64_t* bits, Char c)
+            {
+                unsigned int const i = static_cast<unsigned char>(c);
+                bits[i / 64] |= boost::uint64_t(1) << (i % 64);
+            }
+
+            static bool test(boost::uint64_t const* bits, Char c)
+            {
+                unsigned int const i = static_cast<unsigned char>(c);
+                return (bits[i / 64] >> (i % 64)) & 1;
+            }
+
+            static boost::uint64_t pack(boost::uint64_t key, Char c)
+            {
+                typedef typename boost::make_unsigned<Char>::type unsigned_type;
+                boost::uint64_t const value =
+                    static_cast<boost::uint64_t>(static_cast<unsigned_type>(c));
+                return bits < 64 ? (key << (bits % 64)) | value : value;
+            }
+        };
+
+        inline boost::uint64_t perfect_hash_mix(boost::uint64_t h)
+        {
+            h *= 0xff51afd7ed558ccdULL;
+            return h ^ (h >> 29);
+        }
+
+        // map x to [0, n) without a division
+        inline boost::uint32_t perfect_hash_reduce(boost::uint32_t x
+          , std::size_t n)
+        {
+            return static_cast<boost::uint32_t>(
+                (static_cast<boost::uint64_t>(x) * n) >> 32);
+        }
+
+        // the slot of the key with the hash h in a table of size n
+        inline boost::uint32_t perfect_hash_slot(boost::uint64_t h
+          , boost::uint32_t displacement, std::size_t n)
+        {
+            boost::uint32_t const h1 = static_cast<boost::uint32_t>(h);
+            boost::uint32_t const h2 = static_cast<boost::uint32_t>(h >> 32) | 1;
+            return perfect_hash_reduce(h1 + displacement * h2, n);
+        }
+
+        // The number of characters readable past the end of the compared
+        // ranges (perfect_hash_equal reads whole blocks of 16 bytes).
+        template <typename Char>
+        struct perfect_hash_padding
+        {
+            static std::size_t const value = (16 + sizeof(Char) - 1) / sizeof(Char);
+        };
+
+        // compare n characters, 16 bytes at a time if possible
+        template <typename Char>
+        inline bool perfect_hash_equal(Char const* lhs, Char const* rhs
+          , std::size_t n)
+        {
+#if defined(BOOST_SPIRIT_QI_SSE2)
+            if (16 % sizeof(Char) == 0)
+            {
+                char const* a = reinterpret_cast<char const*>(lhs);
+                char const* b = reinterpret_cast<char const*>(rhs);
+                std::size_t bytes = n * sizeof(Char);
+                for (/**/; bytes >= 16; bytes -= 16, a += 16, b += 16)
+                {
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi8(
+                            _mm_loadu_si128(reinterpret_cast<__m128i const*>(a))
+                          , _mm_loadu_si128(reinterpret_cast<__m128i const*>(b))
+                        )) != 0xffff)
+                    {
+                        return false;
+                    }
+                }
+
+                // the remaining bytes are compared as a whole block as well,
+                // ignoring the result for the bytes past the end
+                unsigned int const mask = (1u << bytes) - 1;
+                return (~_mm_movemask_epi8(_mm_cmpeq_epi8(
+                        _mm_loadu_si128(reinterpret_cast<__m128i const*>(a))
+                      , _mm_loadu_si128(reinterpret_cast<__m128i const*>(b))
+                    )) & mask) == 0;
+            }
+#endif
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                if (!(lhs[i] == rhs[i]))
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  perfect_hash is a symbols lookup (see tst) meant for fixed keyword
+    //  sets. freeze() chooses the shortest prefix length distinguishing the
+    //  entries into groups of at most a few candidates and builds a minimal
+    //  perfect hash table (using hash and displace) of these prefixes, plus
+    //  one for the entries shorter than the prefix for each of their
+    //  lengths. A lookup hashes the prefix of the input once, and compares
+    //  the input with the candidates, longest first (16 bytes at a time if
+    //  SSE2 is available, define BOOST_SPIRIT_QI_NO_SIMD to disable). Adding 
+    //  new entries or removing entries thaws the perfect_hash (lookups fall 
+    //  back to a slower std::map based search) until freeze() is called 
+    //  again.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Char, typename T>
+    struct perfect_hash
+    {
+        typedef Char char_type; // the character type
+        typedef T value_type; // the value associated with each entry
+        typedef detail::perfect_hash_table<Char, T> table;
+        typedef typename table::slot slot;
+        typedef detail::perfect_hash_candidate<Char, T> candidate;
+
+        perfect_hash()
+        {
+            thaw();
+        }
+
+        perfect_hash(perfect_hash const& rhs)
+          : entries(rhs.entries)
+        {
+            thaw();
+            if (rhs.frozen())
+                freeze();
+        }
+
+        perfect_hash& operator=(perfect_hash const& rhs)
+        {
+            if (this != &rhs)
+            {
+                thaw();
+                entries = rhs.entries;
+                if (rhs.frozen())
+                    freeze();
+            }
+            return *this;
+        }
+
+        template <typename Iterator, typename Filter>
+        T* find(Iterator& first, Iterator last, Filter filter) const
+        {
+            if (tables.empty())
+                return find_thawed(first, last, filter);
+
+            // the input is copied (and filtered) into a buffer as far as
+            // needed for comparing it with the candidates
+            if (max_length > buffer_size)
+            {
+                std::vector<Char> buffer(max_length +
+                    detail::perfect_hash_padding<Char>::value);
+                return find_frozen(first, last, filter, &buffer.front());
+            }
+
+            Char buffer[buffer_size + detail::perfect_hash_padding<Char>::value];
+            return find_frozen(first, last, filter, buffer);
+        }
+
+        template <typename Iterator>
+        T* find(Iterator& first, Iterator last) const
+        {
+            return find(first, last, tst_pass_through());
+        }
+
+        template <typename Iterator>
+        T* add(
+            Iterator first
+          , Iterator last
+          , typename boost::call_traits<T>::param_type val)
+        {
+            if (first == last)
+                return 0;
+
+            // an existing entry is returned without thawing
+            string_type key(first, last);
+            typename entries_type::iterator it = entries.find(key);
+            if (it != entries.end())
+                return &it->second;
+
+            thaw();
+            return &entries.insert(
+                typename entries_type::value_type(key, val)).first->second;
+        }
+
+        template <typename Iterator>
+        void remove(Iterator first, Iterator last)
+        {
+            typename entries_type::iterator it =
+                entries.find(string_type(first, last));
+            if (it != entries.end())
+            {
+                thaw();
+                entries.erase(it);
+            }
+        }
+
+        void clear()
+        {
+            thaw();
+            entries.clear();
+        }
+
+        template <typename F>
+        void for_each(F f) const
+        {
+            typedef typename entries_type::iterator iterator;
+            for (iterator it = entries.begin(); it != entries.end(); ++it)
+                f(it->first, it->second);
+        }
+
+        // build the hash tables for all current entries
+        void freeze()
+        {
+            typedef typename entries_type::iterator iterator;
+
+            thaw();
+            if (entries.empty())
+                return;
+
+            std::size_t const prefix = prefix_length();
+            std::vector<std::vector<boost::uint64_t> > keys(prefix);
+            std::vector<std::vector<slot> > groups(prefix);
+
+            // The entries having the same prefix are adjacent in the
+            // (sorted) map, the entries shorter than the prefix form a
+            // group of their own.
+            for (iterator it = entries.begin(); it != entries.end(); ++it)
+            {
+                string_type const& s = it->first;
+                std::size_t const n = (std::min)(s.size(), prefix);
+
+                boost::uint64_t key = 0;
+                for (std::size_t j = 0; j != n; ++j)
+                    key = traits::pack(key, s[j]);
+
+                if (n < prefix || keys[n-1].empty() || keys[n-1].back() != key)
+                {
+                    slot group = { key
+                      , static_cast<boost::uint32_t>(candidates.size())
+                      , static_cast<boost::uint32_t>(candidates.size()) };
+                    keys[n-1].push_back(key);
+                    groups[n-1].push_back(group);
+                }
+
+                candidate c = {
+                    static_cast<boost::uint32_t>(chars.size())
+                  , static_cast<boost::uint32_t>(s.size())
+                  , &it->second };
+                candidates.push_back(c);
+                groups[n-1].back().last =
+                    static_cast<boost::uint32_t>(candidates.size());
+
+                chars.insert(chars.end(), s.begin(), s.end());
+                traits::set(first_chars, s[0]);
+                max_length = (std::max)(max_length, s.size());
+            }
+            chars.resize(chars.size() + detail::perfect_hash_padding<Char>::value);
+
+            tables.resize(prefix);
+            for (std::size_t n = 0; n != prefix; ++n)
+            {
+                std::vector<slot> const& group = groups[n];
+                for (std::size_t j = 0; j != group.size(); ++j)
+                {
+                    std::stable_sort(
+                        candidates.begin() + group[j].first
+                      , candidates.begin() + group[j].last
+                      , detail::perfect_hash_longer<Char, T>());
+                }
+
+                if (!keys[n].empty())
+                    build_table(tables[n], keys[n], group);
+            }
+        }
+
+        // drop the hash tables
+        void thaw()
+        {
+            std::vector<table>().swap(tables);
+            std::vector<candidate>().swap(candidates);
+            std::vector<Char>().swap(chars);
+            std::fill(first_chars, first_chars + 4, 0);
+            max_length = 0;
+        }
+
+        bool frozen() const
+        {
+            return !tables.empty();
+        }
+
+    private:
+        typedef std::basic_string<Char> string_type;
+        typedef std::map<string_type, T> entries_type;
+        typedef detail::perfect_hash_traits<Char> traits;
+
+        enum
+        {
+            buffer_size = 64,       // input buffered on the stack
+            max_candidates = 4      // entries sharing a prefix
+        };
+
+        static boost::uint32_t probe(table const& t, boost::uint64_t key)
+        {
+            boost::uint64_t const h = detail::perfect_hash_mix(key ^ t.seed);
+            return detail::perfect_hash_slot(h
+              , t.displacements[detail::perfect_hash_reduce(
+                    static_cast<boost::uint32_t>(h >> 32)
+                  , t.displacements.size())]
+              , t.slots.size());
+        }
+
+        // the shortest prefix length leaving at most max_candidates
+        // entries with the same prefix
+        std::size_t prefix_length() const
+        {
+            typedef typename entries_type::const_iterator iterator;
+
+            std::size_t prefix = 1;
+            for (/**/; prefix != traits::max_prefix; ++prefix)
+            {
+                std::size_t count = 0;
+                iterator previous = entries.end();
+                for (iterator it = entries.begin(); it != entries.end(); ++it)
+                {
+                    if (it->first.size() < prefix)
+                        continue;
+
+                    if (previous != entries.end() && previous->first.compare(
+                            0, prefix, it->first, 0, prefix) == 0)
+                    {
+                        if (++count > max_candidates)
+                            break;
+                    }
+                    else
+                    {
+                        count = 1;
+                    }
+                    previous = it;
+                }
+                if (count <= max_candidates)
+                    break;
+            }
+            return prefix;
+        }
+
+        // Hash and displace: the keys are distributed over n/4 buckets,
+        // starting with the largest bucket the smallest displacement is
+        // searched, which moves all keys of the bucket to free slots.
+        static void build_table(table& t
+          , std::vector<boost::uint64_t> const& keys
+          , std::vector<slot> const& groups)
+        {
+            std::size_t const n = keys.size();
+            std::size_t const size = (n + 3) / 4;
+            boost::uint32_t const max_displacement =
+                static_cast<boost::uint32_t>(64 * n + 1024);
+            std::vector<boost::uint32_t> slot_of(n);
+
+            for (t.seed = 0; /**/; ++t.seed)
+            {
+                std::vector<std::vector<std::size_t> > buckets(size);
+                std::vector<boost::uint64_t> hashes(n);
+                for (std::size_t i = 0; i != n; ++i)
+                {
+                    hashes[i] = detail::perfect_hash_mix(keys[i] ^ t.seed);
+                    buckets[detail::perfect_hash_reduce(
+                        static_cast<boost::uint32_t>(hashes[i] >> 32), size)
+                    ].push_back(i);
+                }
+
+                std::vector<std::pair<std::size_t, std::size_t> > order;
+                for (std::size_t b = 0; b != size; ++b)
+                {
+                    if (!buckets[b].empty())
+                        order.push_back(std::make_pair(buckets[b].size(), b));
+                }
+                std::sort(order.rbegin(), order.rend());
+
+                std::vector<bool> used(n, false);
+                std::vector<boost::uint32_t> slots;
+                t.displacements.assign(size, 0);
+
+                bool success = true;
+                for (std::size_t b = 0; b != order.size(); ++b)
+                {
+                    std::vector<std::size_t> const& bucket =
+                        buckets[order[b].second];
+
+                    boost::uint32_t d = 0;
+                    for (/**/; d != max_displacement; ++d)
+                    {
+                        slots.clear();
+                        for (std::size_t j = 0; j != bucket.size(); ++j)
+                        {
+                            boost::uint32_t const s = detail::perfect_hash_slot(
+                                hashes[bucket[j]], d, n);
+                            if (used[s] || std::find(slots.begin()
+                                  , slots.end(), s) != slots.end())
+                            {
+                                break;
+                            }
+                            slots.push_back(s);
+                        }
+                        if (slots.size() == bucket.size())
+                            break;
+                    }
+
+                    if (d == max_displacement)
+                    {
+                        success = false;
+                        break;
+                    }
+
+                    t.displacements[order[b].second] = d;
+                    for (std::size_t j = 0; j != bucket.size(); ++j)
+                    {
+                        used[slots[j]] = true;
+                        slot_of[bucket[j]] = slots[j];
+                    }
+                }
+
+                if (success)
+                    break;
+            }
+
+            t.slots.resize(n);
+            for (std::size_t i = 0; i != n; ++i)
+                t.slots[slot_of[i]] = groups[i];
+        }
+
+        // the lookup used while frozen
+        template <typename Iterator, typename Filter>
+        T* find_frozen(Iterator& first, Iterator last, Filter filter
+          , Char* buffer) const
+        {
+            Iterator i = first;
+            if (i == last)
+                return 0;
+
+            // reject the input not starting like any of the entries early
+            buffer[0] = filter(*i);
+            if (!traits::test(first_chars, buffer[0]))
+                return 0;
+
+            boost::uint64_t keys[traits::max_prefix];
+            boost::uint64_t key = 0;
+            std::size_t size = 0;
+            for (/**/; size != tables.size() && i != last; ++i)
+            {
+                if (size != 0)
+                    buffer[size] = filter(*i); // filter only the input
+                key = traits::pack(key, buffer[size]);
+                keys[size++] = key;
+            }
+
+            // longest prefix first, the candidates are sorted by length
+            for (std::size_t n = size; n != 0; --n)
+            {
+                table const& t = tables[n-1];
+                if (t.slots.empty())
+                    continue;
+
+                slot const& s = t.slots[probe(t, keys[n-1])];
+                if (s.key != keys[n-1])
+                    continue;
+
+                candidate const* c = &candidates.front() + s.first;
+                candidate const* const end = &candidates.front() + s.last;
+                for (/**/; size < c->length && i != last; ++i)
+                    buffer[size++] = filter(*i);
+
+                for (/**/; c != end; ++c)
+                {
+                    if (c->length <= size && detail::perfect_hash_equal(
+                            buffer, &chars.front() + c->offset, c->length))
+                    {
+                        std::advance(first, c->length);
+                        return c->data;
+                    }
+                }
+            }
+            return 0;
+        }
+
+        // the lookup used while not frozen
+        template <typename Iterator, typename Filter>
+        T* find_thawed(Iterator& first, Iterator last, Filter filter) const
+        {
+            Iterator i = first;
+            Iterator latest = first;
+            string_type prefix;
+            T* found = 0;
+
+            for (/**/; i != last; ++i)
+            {
+                prefix += filter(*i);
+
+                typename entries_type::iterator it = entries.lower_bound(prefix);
+                if (it == entries.end() ||
+                    it->first.compare(0, prefix.size(), prefix) != 0)
+                {
+                    break;
+                }
+
+                if (it->first.size() == prefix.size())
+                {
+                    found = &it->second;
+                    latest = i;
+                }
+            }
+
+            if (found)
+                first = ++latest; // one past the last matching char
+            return found;
+        }
+
+        // find() hands out pointers to modifiable entries, as tst does
+        mutable entries_type entries;
+        std::vector<table> tables;          // one per prefix length
+        std::vector<candidate> candidates;  // grouped by their prefix
+        std::vector<Char> chars;            // the characters of all entries
+        std::size_t max_length;
+        boost::uint64_t first_chars[4];     // the first characters of all entries
+    };
+}}}
+
+#endif
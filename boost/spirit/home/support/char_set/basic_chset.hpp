@@ -14,6 +14,7 @@
 #endif
 
 ///////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
 #include <bitset>
 #include <climits> 
 #include <boost/spirit/home/support/char_set/range_run.hpp>
@@ -24,17 +25,23 @@ namespace boost { namespace spirit { namespace support { namespace detail
     //
     //  basic_chset: basic character set implementation using range_run
     //
+    //      The characters below 256 are mirrored in a bitset, so that
+    //      testing them (the vast majority of the input for most wide
+    //      character grammars) doesn't need to search the range_run.
+    //
     ///////////////////////////////////////////////////////////////////////////
     template <typename Char>
     struct basic_chset
     {
         basic_chset() {}
         basic_chset(basic_chset const& arg_)
-          : rr(arg_.rr) {}
+          : rr(arg_.rr), low(arg_.low) {}
 
         bool
         test(Char v) const
         {
+            if (is_low(v))
+                return low[static_cast<std::size_t>(v)];
             return rr.test(v);
         }
 
@@ -42,30 +49,35 @@ namespace boost { namespace spirit { namespace support { namespace detail
         set(Char from, Char to)
         {
             rr.set(range<Char>(from, to));
+            set_low(from, to, true);
         }
 
         void
         set(Char c)
         {
             rr.set(range<Char>(c, c));
+            set_low(c, c, true);
         }
 
         void
         clear(Char from, Char to)
         {
             rr.clear(range<Char>(from, to));
+            set_low(from, to, false);
         }
 
         void
         clear(Char c)
         {
             rr.clear(range<Char>(c, c));
+            set_low(c, c, false);
         }
 
         void
         clear()
         {
             rr.clear();
+            low.reset();
         }
 
         void
@@ -84,6 +96,7 @@ namespace boost { namespace spirit { namespace support { namespace detail
         swap(basic_chset& x)
         {
             rr.swap(x.rr);
+            std::swap(low, x.low);
         }
 
 
@@ -93,6 +106,7 @@ namespace boost { namespace spirit { namespace support { namespace detail
             typedef typename range_run<Char>::const_iterator const_iterator;
             for (const_iterator iter = x.rr.begin(); iter != x.rr.end(); ++iter)
                 rr.set(*iter);
+            low |= x.low;
             return *this;
         }
 
@@ -115,6 +129,7 @@ namespace boost { namespace spirit { namespace support { namespace detail
             typedef typename range_run<Char>::const_iterator const_iterator;
             for (const_iterator iter = x.rr.begin(); iter != x.rr.end(); ++iter)
                 rr.clear(*iter);
+            low &= ~x.low;
             return *this;
         }
 
@@ -128,7 +143,28 @@ namespace boost { namespace spirit { namespace support { namespace detail
             return *this;
         }
 
-        private: range_run<Char> rr;
+    private:
+
+        static bool
+        is_low(Char v)
+        {
+            return !(v < Char(0)) && v < Char(256);
+        }
+
+        // update the bits of the characters in [from, to] below 256
+        void
+        set_low(Char from, Char to, bool value)
+        {
+            if (to < Char(0) || !(from < Char(256)))
+                return;
+            std::size_t first = from < Char(0) ? 0 : std::size_t(from);
+            std::size_t last = to < Char(256) ? std::size_t(to) : 255;
+            for (/**/; first <= last; ++first)
+                low[first] = value;
+        }
+
+        range_run<Char> rr;
+        std::bitset<256> low;
     };
 
 #if (CHAR_BIT == 8)
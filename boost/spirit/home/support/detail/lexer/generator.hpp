@@ -15,6 +15,8 @@
 #include "parser/tree/node.hpp"
 #include "parser/parser.hpp"
 #include "containers/ptr_list.hpp"
+#include <map>
+#include "parallel.hpp"
 #include "rules.hpp"
 #include "state_machine.hpp"
 
@@ -29,16 +31,21 @@ public:
     typedef typename detail::internals::size_t_vector size_t_vector;
     typedef basic_rules<CharT> rules;
 
+    // Lexer states are independent of each other, so up to threads_ of them
+    // are built concurrently (0 means one thread per processor). See
+    // parallel.hpp.
     static void build (const rules &rules_,
-        basic_state_machine<CharT> &state_machine_)
+        basic_state_machine<CharT> &state_machine_,
+        const std::size_t threads_ = 1)
     {
         std::size_t index_ = 0;
         std::size_t size_ = rules_.statemap ().size ();
-        node_ptr_vector node_ptr_vector_;
+        std::size_t states_ = 0;
         detail::internals &internals_ = const_cast<detail::internals &>
             (state_machine_.data ());
-        bool seen_BOL_assertion_ = false;
-        bool seen_EOL_assertion_ = false;
+        // One flag per lexer state, as they are built concurrently.
+        std::vector<char> seen_BOL_assertion_ (size_, 0);
+        std::vector<char> seen_EOL_assertion_ (size_, 0);
 
         state_machine_.clear ();
 
@@ -49,65 +56,108 @@ public:
             internals_._dfa_alphabet.push_back (0);
             internals_._dfa->push_back (static_cast<size_t_vector *>(0));
             internals_._dfa->back () = new size_t_vector;
-        }
-
-        for (index_ = 0, size_ = internals_._lookup->size ();
-            index_ < size_; ++index_)
-        {
-            internals_._lookup[index_]->resize (sizeof (CharT) == 1 ?
-                num_chars : num_wchar_ts, dead_state_index);
 
             if (!rules_.regexes ()[index_].empty ())
             {
-                // vector mapping token indexes to partitioned token index sets
-                index_set_vector set_mapping_;
-                // syntax tree
-                detail::node *root_ = build_tree (rules_, index_,
-                    node_ptr_vector_, internals_, set_mapping_);
+                ++states_;
+            }
+        }
 
-                build_dfa (root_, set_mapping_,
-                    internals_._dfa_alphabet[index_],
-                    *internals_._dfa[index_]);
+        // Spare threads are used for building the DFA of each state.
+        const std::size_t threads_per_state_ = states_ ?
+            (detail::thread_count (threads_) + states_ - 1) / states_ : 1;
+        build_state build_state_ (rules_, internals_, seen_BOL_assertion_,
+            seen_EOL_assertion_, threads_per_state_);
 
-                if (internals_._seen_BOL_assertion)
-                {
-                    seen_BOL_assertion_ = true;
-                }
+        detail::parallel_for (size_, threads_, build_state_);
 
-                if (internals_._seen_EOL_assertion)
-                {
-                    seen_EOL_assertion_ = true;
-                }
+        for (index_ = 0; index_ < size_; ++index_)
+        {
+            if (seen_BOL_assertion_[index_])
+            {
+                internals_._seen_BOL_assertion = true;
+            }
 
-                internals_._seen_BOL_assertion = false;
-                internals_._seen_EOL_assertion = false;
+            if (seen_EOL_assertion_[index_])
+            {
+                internals_._seen_EOL_assertion = true;
             }
         }
 
-        internals_._seen_BOL_assertion = seen_BOL_assertion_;
-        internals_._seen_EOL_assertion = seen_EOL_assertion_;
+        build_self_loops (internals_);
+    }
+
+    static void minimise (basic_state_machine<CharT> &state_machine_,
+        const std::size_t threads_ = 1)
+    {
+        detail::internals &internals_ = const_cast<detail::internals &>
+            (state_machine_.data ());
+        const std::size_t machines_ = internals_._dfa->size ();
+        minimise_state minimise_state_ (internals_);
+
+        // State indices change, so compress () has to be called again.
+        internals_._compressed.clear ();
+        detail::parallel_for (machines_, threads_, minimise_state_);
+        build_self_loops (internals_);
     }
 
-    static void minimise (basic_state_machine<CharT> &state_machine_)
+    // Builds narrow-width, row-deduplicated copies of the DFA tables which
+    // are then used by the tokenisers instead of the full size_t tables.
+    // The cell width (1, 2 or 4 bytes) is the smallest type able to hold
+    // every state, column and row index of all the lexer states.
+    static void compress (basic_state_machine<CharT> &state_machine_)
     {
         detail::internals &internals_ = const_cast<detail::internals &>
             (state_machine_.data ());
         const std::size_t machines_ = internals_._dfa->size ();
+        std::size_t max_ = 0;
+
+        internals_._compressed.clear ();
 
         for (std::size_t i_ = 0; i_ < machines_; ++i_)
         {
-            const std::size_t dfa_alphabet_ = internals_._dfa_alphabet[i_];
-            size_t_vector *dfa_ = internals_._dfa[i_];
+            internals_._compressed->push_back
+                (static_cast<detail::compressed_dfa *>(0));
+            internals_._compressed->back () = new detail::compressed_dfa;
+            compress_dfa (*internals_._lookup[i_],
+                internals_._dfa_alphabet[i_], *internals_._dfa[i_],
+                *internals_._compressed[i_], max_);
+        }
 
-            if (dfa_alphabet_ != 0)
+        const std::size_t width_ = max_ <= 0xff ? 1 :
+            max_ <= 0xffff ? 2 : 4;
+
+        for (std::size_t i_ = 0; i_ < machines_; ++i_)
+        {
+            detail::compressed_dfa *compressed_ = internals_._compressed[i_];
+
+            compressed_->_width = width_;
+            compressed_->_size = compressed_->_cells32.size ();
+            compressed_->_accept = &compressed_->_accept_data.front ();
+
+            switch (width_)
             {
-                std::size_t size_ = 0;
+            case 1:
+                compressed_->_cells8.assign (compressed_->_cells32.begin (),
+                    compressed_->_cells32.end ());
+                std::vector<boost::uint32_t> ().swap (compressed_->_cells32);
+                compressed_->_cells = &compressed_->_cells8.front ();
+                break;
+            case 2:
+                compressed_->_cells16.assign (compressed_->_cells32.begin (),
+                    compressed_->_cells32.end ());
+                std::vector<boost::uint32_t> ().swap (compressed_->_cells32);
+                compressed_->_cells = &compressed_->_cells16.front ();
+                break;
+            default:
+                compressed_->_cells = &compressed_->_cells32.front ();
+                break;
+            }
 
-                do
-                {
-                    size_ = dfa_->size ();
-                    minimise_dfa (dfa_alphabet_, *dfa_, size_);
-                } while (dfa_->size () != size_);
+            if (!internals_._self_loops->empty () &&
+                internals_._self_loops[i_]->size () == compressed_->_states)
+            {
+                compressed_->_loops = &internals_._self_loops[i_]->front ();
             }
         }
     }
@@ -136,9 +186,121 @@ protected:
     typedef std::pair<macro_iter, bool> macro_iter_pair;
     typedef typename parser::tokeniser::token_map token_map;
 
+    // Builds the DFA of a single lexer state.
+    struct build_state
+    {
+        const rules &_rules;
+        detail::internals &_internals;
+        std::vector<char> &_seen_BOL_assertion;
+        std::vector<char> &_seen_EOL_assertion;
+        const std::size_t _threads;
+
+        build_state (const rules &rules_, detail::internals &internals_,
+            std::vector<char> &seen_BOL_assertion_,
+            std::vector<char> &seen_EOL_assertion_,
+            const std::size_t threads_) :
+            _rules (rules_),
+            _internals (internals_),
+            _seen_BOL_assertion (seen_BOL_assertion_),
+            _seen_EOL_assertion (seen_EOL_assertion_),
+            _threads (threads_)
+        {
+        }
+
+        void operator () (const std::size_t index_)
+        {
+            _internals._lookup[index_]->resize (sizeof (CharT) == 1 ?
+                num_chars : num_wchar_ts, dead_state_index);
+
+            if (!_rules.regexes ()[index_].empty ())
+            {
+                node_ptr_vector node_ptr_vector_;
+                // vector mapping token indexes to partitioned token index sets
+                index_set_vector set_mapping_;
+                bool seen_BOL_assertion_ = false;
+                bool seen_EOL_assertion_ = false;
+                // syntax tree
+                detail::node *root_ = build_tree (_rules, index_,
+                    node_ptr_vector_, _internals, set_mapping_,
+                    seen_BOL_assertion_, seen_EOL_assertion_);
+
+                build_dfa (root_, set_mapping_,
+                    _internals._dfa_alphabet[index_],
+                    *_internals._dfa[index_], _threads);
+                _seen_BOL_assertion[index_] = seen_BOL_assertion_;
+                _seen_EOL_assertion[index_] = seen_EOL_assertion_;
+            }
+        }
+
+    private:
+        build_state &operator = (const build_state &); // No assignment.
+    };
+
+    // Minimises the DFA of a single lexer state.
+    struct minimise_state
+    {
+        detail::internals &_internals;
+
+        minimise_state (detail::internals &internals_) :
+            _internals (internals_)
+        {
+        }
+
+        void operator () (const std::size_t index_)
+        {
+            const std::size_t dfa_alphabet_ =
+                _internals._dfa_alphabet[index_];
+            size_t_vector *dfa_ = _internals._dfa[index_];
+
+            if (dfa_alphabet_ != 0)
+            {
+                std::size_t size_ = 0;
+
+                do
+                {
+                    size_ = dfa_->size ();
+                    minimise_dfa (dfa_alphabet_, *dfa_, size_);
+                } while (dfa_->size () != size_);
+            }
+        }
+
+    private:
+        minimise_state &operator = (const minimise_state &); // No assignment.
+    };
+
+    // Partitions the transitions of a batch of DFA states.
+    struct partition_states
+    {
+        const node_vector_vector &_seen_vectors;
+        const std::size_t _first;
+        const index_set_vector &_set_mapping;
+        detail::ptr_vector<equivset_list> &_equiv_lists;
+
+        partition_states (const node_vector_vector &seen_vectors_,
+            const std::size_t first_, const index_set_vector &set_mapping_,
+            detail::ptr_vector<equivset_list> &equiv_lists_) :
+            _seen_vectors (seen_vectors_),
+            _first (first_),
+            _set_mapping (set_mapping_),
+            _equiv_lists (equiv_lists_)
+        {
+        }
+
+        void operator () (const std::size_t index_)
+        {
+            build_equiv_list (_seen_vectors[_first + index_], _set_mapping,
+                *_equiv_lists[index_]);
+        }
+
+    private:
+        // No assignment.
+        partition_states &operator = (const partition_states &);
+    };
+
     static detail::node *build_tree (const rules &rules_,
         const std::size_t state_, node_ptr_vector &node_ptr_vector_,
-        detail::internals &internals_, index_set_vector &set_mapping_)
+        detail::internals &internals_, index_set_vector &set_mapping_,
+        bool &seen_BOL_assertion_, bool &seen_EOL_assertion_)
     {
         size_t_vector *lookup_ = internals_._lookup[state_];
         const typename rules::string_deque_deque &regexes_ =
@@ -167,13 +329,13 @@ protected:
 
         build_macros (token_map_, macrodeque_, macromap_,
             rules_.flags (), rules_.locale (), node_ptr_vector_,
-            internals_._seen_BOL_assertion, internals_._seen_EOL_assertion);
+            seen_BOL_assertion_, seen_EOL_assertion_);
 
         detail::node *root_ = parser::parse (regex_.c_str (),
             regex_.c_str () + regex_.size (), *ids_iter_, *unique_ids_iter_,
             *states_iter_, rules_.flags (), rules_.locale (), node_ptr_vector_,
-            macromap_, token_map_, internals_._seen_BOL_assertion,
-            internals_._seen_EOL_assertion);
+            macromap_, token_map_, seen_BOL_assertion_,
+            seen_EOL_assertion_);
 
         ++regex_iter_;
         ++ids_iter_;
@@ -191,8 +353,7 @@ protected:
                 regex_.c_str () + regex_.size (), *ids_iter_,
                 *unique_ids_iter_, *states_iter_, rules_.flags (),
                 rules_.locale (), node_ptr_vector_, macromap_, token_map_,
-                internals_._seen_BOL_assertion,
-                internals_._seen_EOL_assertion);
+                seen_BOL_assertion_, seen_EOL_assertion_);
             tree_vector_.push_back (root_);
             ++regex_iter_;
             ++ids_iter_;
@@ -200,7 +361,7 @@ protected:
             ++states_iter_;
         }
 
-        if (internals_._seen_BOL_assertion)
+        if (seen_BOL_assertion_)
         {
             // Fixup BOLs
             typename detail::node::node_vector::iterator iter_ =
@@ -294,13 +455,16 @@ protected:
 
     static void build_dfa (detail::node *root_,
         const index_set_vector &set_mapping_, const std::size_t dfa_alphabet_,
-        size_t_vector &dfa_)
+        size_t_vector &dfa_, const std::size_t threads_ = 1)
     {
         typename detail::node::node_vector *followpos_ =
             &root_->firstpos ();
         node_set_vector seen_sets_;
         node_vector_vector seen_vectors_;
         size_t_vector hash_vector_;
+        // Partitioned transitions of the states [first_, first_ + size ()).
+        detail::ptr_vector<equivset_list> equiv_lists_;
+        std::size_t first_ = 0;
 
         // 'jam' state
         dfa_.resize (dfa_alphabet_, 0);
@@ -311,9 +475,35 @@ protected:
 
         for (std::size_t index_ = 0; index_ < seen_vectors_->size (); ++index_)
         {
-            equivset_list equiv_list_;
+            if (index_ == first_ + equiv_lists_->size ())
+            {
+                // Partitioning the transitions of a state only reads the
+                // syntax tree, so all of the states seen so far (up to a
+                // limit) are partitioned concurrently. The states are still
+                // numbered in the same order as when built sequentially.
+                std::size_t batch_ = seen_vectors_->size () - index_;
+
+                if (batch_ > threads_ * 16)
+                {
+                    batch_ = threads_ * 16;
+                }
+
+                first_ = index_;
+                equiv_lists_.clear ();
+
+                for (std::size_t i_ = 0; i_ < batch_; ++i_)
+                {
+                    equiv_lists_->push_back (static_cast<equivset_list *>(0));
+                    equiv_lists_->back () = new equivset_list;
+                }
+
+                partition_states partition_states_ (seen_vectors_, first_,
+                    set_mapping_, equiv_lists_);
+
+                detail::parallel_for (batch_, threads_, partition_states_);
+            }
 
-            build_equiv_list (seen_vectors_[index_], set_mapping_, equiv_list_);
+            equivset_list &equiv_list_ = *equiv_lists_[index_ - first_];
 
             for (typename equivset_list::list::const_iterator iter_ =
                 equiv_list_->begin (), end_ = equiv_list_->end ();
@@ -762,6 +952,174 @@ protected:
         }
     }
 
+    static void build_self_loops (detail::internals &internals_)
+    {
+        internals_._self_loops.clear ();
+
+        // Runs are only ever skipped for 8 bit characters.
+        if (sizeof (CharT) != 1) return;
+
+        for (std::size_t i_ = 0, size_ = internals_._dfa->size ();
+            i_ < size_; ++i_)
+        {
+            const std::size_t dfa_alphabet_ = internals_._dfa_alphabet[i_];
+            const size_t_vector &dfa_ = *internals_._dfa[i_];
+            const size_t_vector &lookup_ = *internals_._lookup[i_];
+            const std::size_t states_ = dfa_alphabet_ ?
+                dfa_.size () / dfa_alphabet_ : 0;
+
+            internals_._self_loops->push_back
+                (static_cast<detail::internals::self_loop_vector *>(0));
+            internals_._self_loops->back () =
+                new detail::internals::self_loop_vector (states_);
+
+            for (std::size_t state_ = 1; state_ < states_; ++state_)
+            {
+                build_self_loop (&dfa_.front () + state_ * dfa_alphabet_,
+                    state_, lookup_, (*internals_._self_loops[i_])[state_]);
+            }
+        }
+    }
+
+    static void build_self_loop (const std::size_t *ptr_,
+        const std::size_t state_, const size_t_vector &lookup_,
+        detail::self_loop &loop_)
+    {
+        std::size_t count_ = 0;
+        unsigned char in_[detail::self_loop::max_chars];
+        unsigned char out_[detail::self_loop::max_chars];
+        std::size_t in_count_ = 0;
+        std::size_t out_count_ = 0;
+
+        if (ptr_[bol_index] || ptr_[eol_index]) return;
+
+        for (std::size_t c_ = 0; c_ < num_chars; ++c_)
+        {
+            const std::size_t col_ = lookup_[c_];
+
+            if (col_ != dead_state_index && ptr_[col_] == state_)
+            {
+                loop_._bitmap[c_ / 8] |= static_cast<unsigned char>
+                    (1 << (c_ % 8));
+                ++count_;
+
+                if (in_count_ < detail::self_loop::max_chars)
+                {
+                    in_[in_count_] = static_cast<unsigned char>(c_);
+                }
+
+                ++in_count_;
+            }
+            else
+            {
+                if (out_count_ < detail::self_loop::max_chars)
+                {
+                    out_[out_count_] = static_cast<unsigned char>(c_);
+                }
+
+                ++out_count_;
+            }
+        }
+
+        if (count_ == 0) return;
+
+        if (in_count_ <= detail::self_loop::max_chars)
+        {
+            loop_._kind = detail::self_loop::any_of;
+            std::fill (loop_._chars, loop_._chars +
+                detail::self_loop::max_chars, in_[0]);
+            std::copy (in_, in_ + in_count_, loop_._chars);
+        }
+        else if (out_count_ && out_count_ <= detail::self_loop::max_chars)
+        {
+            loop_._kind = detail::self_loop::none_of;
+            std::fill (loop_._chars, loop_._chars +
+                detail::self_loop::max_chars, out_[0]);
+            std::copy (out_, out_ + out_count_, loop_._chars);
+        }
+        else
+        {
+            loop_._kind = detail::self_loop::bitmap;
+        }
+    }
+
+    static void compress_dfa (const size_t_vector &lookup_,
+        const std::size_t dfa_alphabet_, const size_t_vector &dfa_,
+        detail::compressed_dfa &compressed_, std::size_t &max_)
+    {
+        typedef std::map<size_t_vector, std::size_t> row_map;
+        const std::size_t columns_ = dfa_alphabet_ ?
+            dfa_alphabet_ - dfa_offset + 1 : 1;
+        // Always provide the 'jam' and start states.
+        const std::size_t states_ = dfa_alphabet_ ?
+            dfa_.size () / dfa_alphabet_ : 2;
+        row_map row_map_;
+        size_t_vector row_ (columns_, 0);
+        size_t_vector states_cells_ (states_ *
+            detail::compressed_dfa::state_cells, 0);
+        size_t_vector rows_cells_;
+
+        compressed_._columns = columns_;
+        compressed_._states = states_;
+        compressed_._accept_data.resize (states_ * 3, 0);
+
+        for (std::size_t state_ = 0; state_ < states_; ++state_)
+        {
+            std::size_t *cells_ = &states_cells_.front () +
+                state_ * detail::compressed_dfa::state_cells;
+
+            if (dfa_alphabet_)
+            {
+                const std::size_t *ptr_ = &dfa_.front () +
+                    state_ * dfa_alphabet_;
+
+                std::copy (ptr_ + dfa_offset, ptr_ + dfa_alphabet_,
+                    row_.begin () + 1);
+                cells_[detail::compressed_dfa::end_state_cell] =
+                    ptr_[end_state_index] != 0;
+                cells_[detail::compressed_dfa::bol_cell] = ptr_[bol_index];
+                cells_[detail::compressed_dfa::eol_cell] = ptr_[eol_index];
+                std::size_t *accept_ = &compressed_._accept_data.front () +
+                    state_ * 3;
+
+                accept_[0] = ptr_[id_index];
+                accept_[1] = ptr_[unique_id_index];
+                accept_[2] = ptr_[state_index];
+            }
+
+            typename row_map::const_iterator iter_ = row_map_.find (row_);
+
+            if (iter_ == row_map_.end ())
+            {
+                iter_ = row_map_.insert (typename row_map::value_type
+                    (row_, row_map_.size ())).first;
+                rows_cells_.insert (rows_cells_.end (), row_.begin (),
+                    row_.end ());
+            }
+
+            cells_[detail::compressed_dfa::row_cell] = iter_->second;
+        }
+
+        max_ = (std::max) (max_, (std::max) (states_, columns_));
+        compressed_._states_offset = lookup_.size ();
+        compressed_._rows_offset = compressed_._states_offset +
+            states_cells_.size ();
+        compressed_._cells32.reserve (compressed_._rows_offset +
+            rows_cells_.size ());
+
+        for (typename size_t_vector::const_iterator iter_ = lookup_.begin (),
+            end_ = lookup_.end (); iter_ != end_; ++iter_)
+        {
+            compressed_._cells32.push_back (*iter_ == dead_state_index ?
+                0 : static_cast<boost::uint32_t>(*iter_ - dfa_offset + 1));
+        }
+
+        compressed_._cells32.insert (compressed_._cells32.end (),
+            states_cells_.begin (), states_cells_.end ());
+        compressed_._cells32.insert (compressed_._cells32.end (),
+            rows_cells_.begin (), rows_cells_.end ());
+    }
+
     static void minimise_dfa (const std::size_t dfa_alphabet_,
         size_t_vector &dfa_, std::size_t size_)
     {
@@ -0,0 +1,410 @@
+// image.hpp
+// Copyright (c) 2007-2009 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_LEXER_IMAGE_HPP
+#define BOOST_LEXER_IMAGE_HPP
+
+#include <boost/cstdint.hpp>
+#include "consts.hpp"
+#include "internals.hpp"
+#include <ostream>
+#include "rules.hpp"
+#include "runtime_error.hpp"
+#include "size_t.hpp"
+#include "state_machine.hpp"
+
+// A binary image holds the compressed tables (see basic_generator::compress
+// ()) of a state machine. All positions inside the image are byte offsets
+// from its start and every table is aligned to 8 bytes, so an image can be
+// memory mapped (read-only) and adopted by any number of processes without
+// copying. Images are only portable between platforms sharing endianness and
+// the size of std::size_t.
+//
+// Layout:
+//   image_header
+//   image_dfa[_machines]
+//   per DFA: cells, accept (3 std::size_t per state), self loops (optional)
+namespace boost
+{
+namespace lexer
+{
+namespace detail
+{
+const boost::uint32_t image_magic = 0x4644584c; // "LXDF"
+const boost::uint32_t image_version = 1;
+
+struct image_header
+{
+    boost::uint32_t _magic;
+    boost::uint32_t _version;
+    boost::uint32_t _char_size;
+    boost::uint32_t _size_t_size;
+    boost::uint32_t _width;
+    // 1: BOL assertion seen, 2: EOL assertion seen
+    boost::uint32_t _flags;
+    boost::uint64_t _fingerprint;
+    boost::uint64_t _machines;
+    boost::uint64_t _size;
+};
+
+struct image_dfa
+{
+    boost::uint64_t _columns;
+    boost::uint64_t _states;
+    boost::uint64_t _states_offset;
+    boost::uint64_t _rows_offset;
+    boost::uint64_t _size;
+    boost::uint64_t _cells;
+    boost::uint64_t _accept;
+    // 0 if there are no self loops.
+    boost::uint64_t _loops;
+};
+
+inline std::size_t image_align (const std::size_t pos_)
+{
+    return (pos_ + 7) & ~static_cast<std::size_t>(7);
+}
+
+inline void image_hash (boost::uint64_t &hash_, const void *data_,
+    const std::size_t size_)
+{
+    const unsigned char *ptr_ = static_cast<const unsigned char *>(data_);
+
+    // FNV-1a
+    for (std::size_t i_ = 0; i_ < size_; ++i_)
+    {
+        hash_ ^= ptr_[i_];
+        hash_ *= 0x100000001b3ULL;
+    }
+}
+
+// Returns true if all cells of dfa_ refer to existing rows, columns,
+// states and lexer states, so that walking the tables never leaves them.
+template<typename Cell>
+bool image_check_cells (const compressed_dfa &dfa_,
+    const std::size_t machines_)
+{
+    const Cell *cells_ = dfa_.cells (static_cast<const Cell *>(0));
+    const Cell *states_ = cells_ + dfa_._states_offset;
+    const std::size_t rows_ = (dfa_._size - dfa_._rows_offset) /
+        dfa_._columns;
+
+    for (std::size_t i_ = 0; i_ < dfa_._states_offset; ++i_)
+    {
+        if (cells_[i_] >= dfa_._columns) return false;
+    }
+
+    for (std::size_t state_ = 0; state_ < dfa_._states; ++state_)
+    {
+        const Cell *ptr_ = states_ + state_ * compressed_dfa::state_cells;
+
+        if (ptr_[compressed_dfa::row_cell] >= rows_ ||
+            ptr_[compressed_dfa::bol_cell] >= dfa_._states ||
+            ptr_[compressed_dfa::eol_cell] >= dfa_._states ||
+            dfa_._accept[state_ * 3 + 2] >= machines_)
+        {
+            return false;
+        }
+    }
+
+    for (std::size_t i_ = dfa_._rows_offset; i_ < dfa_._size; ++i_)
+    {
+        if (cells_[i_] >= dfa_._states) return false;
+    }
+
+    return true;
+}
+
+inline bool image_check_cells (const compressed_dfa &dfa_,
+    const std::size_t machines_)
+{
+    switch (dfa_._width)
+    {
+    case 1:
+        return image_check_cells<boost::uint8_t> (dfa_, machines_);
+    case 2:
+        return image_check_cells<boost::uint16_t> (dfa_, machines_);
+    default:
+        break;
+    }
+
+    return image_check_cells<boost::uint32_t> (dfa_, machines_);
+}
+
+template<typename CharT>
+void image_hash (boost::uint64_t &hash_, const std::basic_string<CharT> &str_)
+{
+    const std::size_t size_ = str_.size ();
+
+    image_hash (hash_, &size_, sizeof (size_));
+    image_hash (hash_, str_.c_str (), size_ * sizeof (CharT));
+}
+
+inline void image_hash (boost::uint64_t &hash_,
+    const std::vector<std::size_t> &vec_)
+{
+    const std::size_t size_ = vec_.size ();
+
+    image_hash (hash_, &size_, sizeof (size_));
+
+    if (size_)
+    {
+        image_hash (hash_, &vec_.front (), size_ * sizeof (std::size_t));
+    }
+}
+}
+
+// Returns a hash of the given rules. Passing it to write_image () and
+// adopt_image () makes sure an image is only used with the rules it has
+// been built from.
+template<typename CharT>
+boost::uint64_t image_fingerprint (const basic_rules<CharT> &rules_)
+{
+    typedef basic_rules<CharT> rules;
+    boost::uint64_t hash_ = 0xcbf29ce484222325ULL;
+    const std::size_t flags_ = rules_.flags ();
+
+    detail::image_hash (hash_, &flags_, sizeof (flags_));
+
+    for (typename rules::string_pair_deque::const_iterator iter_ =
+        rules_.macrodeque ().begin (), end_ = rules_.macrodeque ().end ();
+        iter_ != end_; ++iter_)
+    {
+        detail::image_hash (hash_, iter_->first);
+        detail::image_hash (hash_, iter_->second);
+    }
+
+    for (std::size_t state_ = 0, size_ = rules_.regexes ().size ();
+        state_ < size_; ++state_)
+    {
+        const typename rules::string_deque &regexes_ =
+            rules_.regexes ()[state_];
+
+        for (typename rules::string_deque::const_iterator iter_ =
+            regexes_.begin (), end_ = regexes_.end (); iter_ != end_; ++iter_)
+        {
+            detail::image_hash (hash_, *iter_);
+        }
+
+        detail::image_hash (hash_, rules_.ids ()[state_]);
+        detail::image_hash (hash_, rules_.unique_ids ()[state_]);
+        detail::image_hash (hash_, rules_.states ()[state_]);
+    }
+
+    return hash_;
+}
+
+// Writes the compressed tables of state_machine_ as a binary image.
+template<typename CharT>
+void write_image (const basic_state_machine<CharT> &state_machine_,
+    std::ostream &os_, const boost::uint64_t fingerprint_ = 0)
+{
+    const detail::internals &internals_ = state_machine_.data ();
+    const std::size_t machines_ = internals_._compressed->size ();
+    std::vector<detail::image_dfa> dfas_ (machines_);
+    detail::image_header header_;
+    std::size_t pos_ = detail::image_align (sizeof (detail::image_header) +
+        machines_ * sizeof (detail::image_dfa));
+
+    if (machines_ == 0)
+    {
+        throw runtime_error ("State machine has not been compressed.");
+    }
+
+    for (std::size_t i_ = 0; i_ < machines_; ++i_)
+    {
+        const detail::compressed_dfa &dfa_ = *internals_._compressed[i_];
+        detail::image_dfa &entry_ = dfas_[i_];
+
+        entry_._columns = dfa_._columns;
+        entry_._states = dfa_._states;
+        entry_._states_offset = dfa_._states_offset;
+        entry_._rows_offset = dfa_._rows_offset;
+        entry_._size = dfa_._size;
+        entry_._cells = pos_;
+        pos_ = detail::image_align (pos_ + dfa_._size * dfa_._width);
+        entry_._accept = pos_;
+        pos_ = detail::image_align (pos_ +
+            dfa_._states * 3 * sizeof (std::size_t));
+        entry_._loops = 0;
+
+        if (dfa_._loops)
+        {
+            entry_._loops = pos_;
+            pos_ = detail::image_align (pos_ +
+                dfa_._states * sizeof (detail::self_loop));
+        }
+    }
+
+    header_._magic = detail::image_magic;
+    header_._version = detail::image_version;
+    header_._char_size = sizeof (CharT);
+    header_._size_t_size = sizeof (std::size_t);
+    header_._width = static_cast<boost::uint32_t>
+        (internals_._compressed[0]->_width);
+    header_._flags = (internals_._seen_BOL_assertion ? 1 : 0) |
+        (internals_._seen_EOL_assertion ? 2 : 0);
+    header_._fingerprint = fingerprint_;
+    header_._machines = machines_;
+    header_._size = pos_;
+
+    os_.write (reinterpret_cast<const char *>(&header_), sizeof (header_));
+    os_.write (reinterpret_cast<const char *>(&dfas_.front ()),
+        machines_ * sizeof (detail::image_dfa));
+    pos_ = sizeof (header_) + machines_ * sizeof (detail::image_dfa);
+
+    const char padding_[8] = {0};
+
+    for (std::size_t i_ = 0; i_ < machines_; ++i_)
+    {
+        const detail::compressed_dfa &dfa_ = *internals_._compressed[i_];
+        const detail::image_dfa &entry_ = dfas_[i_];
+
+        os_.write (padding_, entry_._cells - pos_);
+        os_.write (static_cast<const char *>(dfa_._cells),
+            dfa_._size * dfa_._width);
+        pos_ = entry_._cells + dfa_._size * dfa_._width;
+        os_.write (padding_, entry_._accept - pos_);
+        os_.write (reinterpret_cast<const char *>(dfa_._accept),
+            dfa_._states * 3 * sizeof (std::size_t));
+        pos_ = entry_._accept + dfa_._states * 3 * sizeof (std::size_t);
+
+        if (entry_._loops)
+        {
+            os_.write (padding_, entry_._loops - pos_);
+            os_.write (reinterpret_cast<const char *>(dfa_._loops),
+                dfa_._states * sizeof (detail::self_loop));
+            pos_ = entry_._loops + dfa_._states * sizeof (detail::self_loop);
+        }
+    }
+
+    os_.write (padding_, header_._size - pos_);
+}
+
+// Makes state_machine_ use the tables of the binary image at data_ without
+// copying them. The image has to stay valid (mapped) as long as the state
+// machine uses it. data_ must be aligned to 8 bytes. The layout and every
+// cell of the image are checked against its size before it is used, so a
+// truncated or corrupt image is rejected rather than read out of bounds.
+template<typename CharT>
+void adopt_image (basic_state_machine<CharT> &state_machine_,
+    const void *data_, const std::size_t size_,
+    const boost::uint64_t fingerprint_ = 0)
+{
+    const char *image_ = static_cast<const char *>(data_);
+    const detail::image_header *header_ =
+        static_cast<const detail::image_header *>(data_);
+
+    if (reinterpret_cast<std::size_t>(data_) % 8 != 0)
+    {
+        throw runtime_error ("DFA image is not aligned.");
+    }
+
+    if (size_ < sizeof (detail::image_header) ||
+        header_->_magic != detail::image_magic ||
+        header_->_version != detail::image_version ||
+        header_->_char_size != sizeof (CharT) ||
+        header_->_size_t_size != sizeof (std::size_t))
+    {
+        throw runtime_error ("Incompatible DFA image.");
+    }
+
+    if (header_->_fingerprint != fingerprint_)
+    {
+        throw runtime_error ("DFA image does not match the rules.");
+    }
+
+    if (header_->_size > size_ || header_->_machines == 0 ||
+        header_->_machines > (size_ - sizeof (detail::image_header)) /
+            sizeof (detail::image_dfa))
+    {
+        throw runtime_error ("Truncated DFA image.");
+    }
+
+    const detail::image_dfa *dfas_ = reinterpret_cast
+        <const detail::image_dfa *>(image_ + sizeof (detail::image_header));
+    const std::size_t machines_ =
+        static_cast<std::size_t>(header_->_machines);
+    const std::size_t width_ = header_->_width;
+    // The tokeniser indexes the lookup table with any character value.
+    const boost::uint64_t lookup_size_ = sizeof (CharT) == 1 ?
+        num_chars : num_wchar_ts;
+    const boost::uint64_t image_size_ = header_->_size;
+    detail::internals &internals_ = const_cast<detail::internals &>
+        (state_machine_.data ());
+
+    if (width_ != 1 && width_ != 2 && width_ != 4)
+    {
+        throw runtime_error ("Corrupt DFA image.");
+    }
+
+    state_machine_.clear ();
+
+    for (std::size_t i_ = 0; i_ < machines_; ++i_)
+    {
+        const detail::image_dfa &entry_ = dfas_[i_];
+        const std::size_t states_ = static_cast<std::size_t>(entry_._states);
+
+        // All sizes are bounded by the image size first, so that none of
+        // the sums below can overflow.
+        if (entry_._cells > image_size_ || entry_._accept > image_size_ ||
+            entry_._loops > image_size_ ||
+            entry_._size > image_size_ / width_ ||
+            entry_._states > image_size_ / (3 * sizeof (std::size_t)) ||
+            entry_._cells + entry_._size * width_ > image_size_ ||
+            entry_._accept + entry_._states * 3 * sizeof (std::size_t) >
+                image_size_ ||
+            (entry_._loops && entry_._loops + entry_._states *
+                sizeof (detail::self_loop) > image_size_) ||
+            entry_._cells % 8 != 0 || entry_._accept % 8 != 0)
+        {
+            state_machine_.clear ();
+            throw runtime_error ("Truncated DFA image.");
+        }
+
+        if (states_ < 2 || entry_._columns == 0 ||
+            entry_._states_offset != lookup_size_ ||
+            entry_._rows_offset != entry_._states_offset + entry_._states *
+                detail::compressed_dfa::state_cells ||
+            entry_._rows_offset > entry_._size ||
+            (entry_._size - entry_._rows_offset) % entry_._columns != 0)
+        {
+            state_machine_.clear ();
+            throw runtime_error ("Corrupt DFA image.");
+        }
+
+        internals_._compressed->push_back
+            (static_cast<detail::compressed_dfa *>(0));
+        internals_._compressed->back () = new detail::compressed_dfa;
+
+        detail::compressed_dfa &dfa_ = *internals_._compressed->back ();
+
+        dfa_._width = width_;
+        dfa_._columns = static_cast<std::size_t>(entry_._columns);
+        dfa_._states = states_;
+        dfa_._states_offset =
+            static_cast<std::size_t>(entry_._states_offset);
+        dfa_._rows_offset = static_cast<std::size_t>(entry_._rows_offset);
+        dfa_._size = static_cast<std::size_t>(entry_._size);
+        dfa_._cells = image_ + entry_._cells;
+        dfa_._accept = reinterpret_cast<const std::size_t *>
+            (image_ + entry_._accept);
+        dfa_._loops = entry_._loops ? reinterpret_cast
+            <const detail::self_loop *>(image_ + entry_._loops) : 0;
+
+        if (!detail::image_check_cells (dfa_, machines_))
+        {
+            state_machine_.clear ();
+            throw runtime_error ("Corrupt DFA image.");
+        }
+    }
+
+    internals_._seen_BOL_assertion = (header_->_flags & 1) != 0;
+    internals_._seen_EOL_assertion = (header_->_flags & 2) != 0;
+}
+}
+}
+
+#endif
@@ -6,6 +6,8 @@
 #ifndef BOOST_LEXER_INTERNALS_HPP
 #define BOOST_LEXER_INTERNALS_HPP
 
+#include <algorithm>
+#include <boost/cstdint.hpp>
 #include "containers/ptr_vector.hpp"
 
 namespace boost
@@ -14,14 +16,130 @@ namespace lexer
 {
 namespace detail
 {
+// Characters keeping a DFA state in that very state. basic_generator
+// builds these for 8 bit characters only, so that tokenisers can consume
+// whole runs of such characters at once. States with BOL or EOL transitions
+// are never marked. Consists of bytes only, so that it can be stored in
+// binary images as is.
+struct self_loop
+{
+    // any_of: loop while the character is one of _chars
+    // none_of: loop while the character is none of _chars
+    // bitmap: loop while the character's bit is set in _bitmap
+    enum kind {no_loop, any_of, none_of, bitmap};
+    enum {max_chars = 4};
+
+    unsigned char _kind;
+    // Unused slots repeat the first character.
+    unsigned char _chars[max_chars];
+    unsigned char _bitmap[256 / 8];
+
+    self_loop () :
+        _kind (no_loop)
+    {
+        std::fill (_chars, _chars + max_chars, 0);
+        std::fill (_bitmap, _bitmap + sizeof (_bitmap), 0);
+    }
+
+    bool operator == (const self_loop &rhs_) const
+    {
+        return _kind == rhs_._kind &&
+            std::equal (_chars, _chars + max_chars, rhs_._chars) &&
+            std::equal (_bitmap, _bitmap + sizeof (_bitmap), rhs_._bitmap);
+    }
+};
+
+// Narrow-width, row-deduplicated copy of a single DFA as built by
+// basic_generator::compress (). The tables are accessed through _cells,
+// _accept and _loops only, which either point into the vectors below or
+// into an external (e.g. memory mapped) binary image. Cells are laid out as:
+//   [lookup: char -> column]
+//   [states: row, end state, BOL state, EOL state]
+//   [rows: deduplicated transitions, column 0 is the dead column]
+struct compressed_dfa
+{
+    typedef std::vector<std::size_t> size_t_vector;
+    enum {row_cell, end_state_cell, bol_cell, eol_cell, state_cells};
+
+    // Size in bytes of a single cell (1, 2 or 4).
+    std::size_t _width;
+    std::size_t _columns;
+    std::size_t _states;
+    std::size_t _states_offset;
+    std::size_t _rows_offset;
+    std::size_t _size;
+    const void *_cells;
+    // id, unique_id and lexer state for every DFA state.
+    const std::size_t *_accept;
+    // Self loop of every DFA state or 0.
+    const self_loop *_loops;
+
+    // Storage used if not adopted from an image. Only one of the cell
+    // vectors is used, according to _width.
+    size_t_vector _accept_data;
+    std::vector<boost::uint8_t> _cells8;
+    std::vector<boost::uint16_t> _cells16;
+    std::vector<boost::uint32_t> _cells32;
+
+    compressed_dfa () :
+        _width (0),
+        _columns (0),
+        _states (0),
+        _states_offset (0),
+        _rows_offset (0),
+        _size (0),
+        _cells (0),
+        _accept (0),
+        _loops (0)
+    {
+    }
+
+    const boost::uint8_t *cells (const boost::uint8_t *) const
+    {
+        return static_cast<const boost::uint8_t *>(_cells);
+    }
+
+    const boost::uint16_t *cells (const boost::uint16_t *) const
+    {
+        return static_cast<const boost::uint16_t *>(_cells);
+    }
+
+    const boost::uint32_t *cells (const boost::uint32_t *) const
+    {
+        return static_cast<const boost::uint32_t *>(_cells);
+    }
+
+    bool operator == (const compressed_dfa &rhs_) const
+    {
+        return _width == rhs_._width && _columns == rhs_._columns &&
+            _states == rhs_._states &&
+            _states_offset == rhs_._states_offset &&
+            _rows_offset == rhs_._rows_offset && _size == rhs_._size &&
+            std::equal (_accept, _accept + _states * 3, rhs_._accept) &&
+            std::equal (static_cast<const unsigned char *>(_cells),
+                static_cast<const unsigned char *>(_cells) + _size * _width,
+                static_cast<const unsigned char *>(rhs_._cells)) &&
+            (_loops == 0) == (rhs_._loops == 0) &&
+            (_loops == 0 || std::equal (_loops, _loops + _states,
+                rhs_._loops));
+    }
+};
+
 struct internals
 {
     typedef std::vector<std::size_t> size_t_vector;
     typedef ptr_vector<size_t_vector> size_t_vector_vector;
+    typedef ptr_vector<compressed_dfa> compressed_dfa_vector;
+    typedef std::vector<self_loop> self_loop_vector;
+    typedef ptr_vector<self_loop_vector> self_loop_vector_vector;
 
     size_t_vector_vector _lookup;
     size_t_vector _dfa_alphabet;
     size_t_vector_vector _dfa;
+    // Empty unless basic_generator::compress () has been called.
+    compressed_dfa_vector _compressed;
+    // One entry per DFA state, empty for wide characters.
+    self_loop_vector_vector _self_loops;
     bool _seen_BOL_assertion;
     bool _seen_EOL_assertion;
 
@@ -36,6 +154,8 @@ struct internals
         _lookup.clear ();
         _dfa_alphabet.clear ();
         _dfa.clear ();
+        _compressed.clear ();
+        _self_loops.clear ();
         _seen_BOL_assertion = false;
         _seen_EOL_assertion = false;
     }
@@ -45,6 +165,8 @@ struct internals
         _lookup->swap (*internals_._lookup);
         _dfa_alphabet.swap (internals_._dfa_alphabet);
         _dfa->swap (*internals_._dfa);
+        _compressed->swap (*internals_._compressed);
+        _self_loops->swap (*internals_._self_loops);
         std::swap (_seen_BOL_assertion, internals_._seen_BOL_assertion);
         std::swap (_seen_EOL_assertion, internals_._seen_EOL_assertion);
     }
@@ -0,0 +1,186 @@
+// parallel.hpp
+// Copyright (c) 2007-2009 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_LEXER_PARALLEL_HPP
+#define BOOST_LEXER_PARALLEL_HPP
+
+#include <cstddef>
+#include <new>
+#include "runtime_error.hpp"
+#include <string>
+
+#if defined(BOOST_SPIRIT_THREADSAFE)
+#include <boost/bind.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#endif
+
+// Threads are only used if BOOST_SPIRIT_THREADSAFE is defined (which
+// requires linking with Boost.Thread), otherwise every loop runs
+// sequentially.
+namespace boost
+{
+namespace lexer
+{
+namespace detail
+{
+// Returns the number of threads to use for a requested count of threads_,
+// where 0 means one thread per processor.
+inline std::size_t thread_count (const std::size_t threads_)
+{
+#if defined(BOOST_SPIRIT_THREADSAFE)
+    if (threads_ == 0)
+    {
+        const std::size_t count_ = boost::thread::hardware_concurrency ();
+
+        return count_ ? count_ : 1;
+    }
+
+    return threads_;
+#else
+    (void) threads_;
+    return 1;
+#endif
+}
+
+#if defined(BOOST_SPIRIT_THREADSAFE)
+// Hands out the indexes [0, size_) one at a time to every thread calling
+// run (). The first error stops the loop and is rethrown by rethrow ().
+template<typename F>
+class parallel_loop
+{
+public:
+    parallel_loop (F &f_, const std::size_t size_) :
+        _f (f_),
+        _next (0),
+        _size (size_),
+        _error (none)
+    {
+    }
+
+    void run ()
+    {
+        for (;;)
+        {
+            std::size_t index_ = 0;
+
+            {
+                boost::mutex::scoped_lock lock_ (_mutex);
+
+                if (_next >= _size || _error != none) break;
+
+                index_ = _next++;
+            }
+
+            try
+            {
+                _f (index_);
+            }
+            catch (const std::bad_alloc &)
+            {
+                fail (bad_alloc, std::string ());
+            }
+            catch (const std::exception &e_)
+            {
+                fail (exception, e_.what ());
+            }
+            catch (...)
+            {
+                fail (exception, "Unknown error building lexer.");
+            }
+        }
+    }
+
+    void rethrow () const
+    {
+        switch (_error)
+        {
+        case bad_alloc:
+            throw std::bad_alloc ();
+        case exception:
+            throw runtime_error (_what);
+        default:
+            break;
+        }
+    }
+
+private:
+    enum error {none, bad_alloc, exception};
+
+    F &_f;
+    boost::mutex _mutex;
+    std::size_t _next;
+    const std::size_t _size;
+    error _error;
+    std::string _what;
+
+    void fail (const error error_, const std::string &what_)
+    {
+        boost::mutex::scoped_lock lock_ (_mutex);
+
+        if (_error == none)
+        {
+            _error = error_;
+            _what = what_;
+        }
+    }
+
+    parallel_loop (const parallel_loop &); // No copy construction.
+    parallel_loop &operator = (const parallel_loop &); // No assignment.
+};
+#endif
+
+// Calls f_ (index_) for every index_ in [0, size_), using up to threads_
+// threads (0 means one per processor). f_ must be safe to call concurrently
+// for different indexes.
+template<typename F>
+void parallel_for (const std::size_t size_, const std::size_t threads_,
+    F &f_)
+{
+#if defined(BOOST_SPIRIT_THREADSAFE)
+    std::size_t count_ = thread_count (threads_);
+
+    if (count_ > size_)
+    {
+        count_ = size_;
+    }
+
+    if (count_ > 1)
+    {
+        parallel_loop<F> loop_ (f_, size_);
+        boost::thread_group group_;
+
+        try
+        {
+            for (std::size_t i_ = 1; i_ < count_; ++i_)
+            {
+                group_.create_thread (boost::bind
+                    (&parallel_loop<F>::run, &loop_));
+            }
+        }
+        catch (...)
+        {
+            // Carry on with the threads created so far.
+        }
+
+        loop_.run ();
+        group_.join_all ();
+        loop_.rethrow ();
+        return;
+    }
+#else
+    (void) threads_;
+#endif
+
+    for (std::size_t index_ = 0; index_ < size_; ++index_)
+    {
+        f_ (index_);
+    }
+}
+}
+}
+}
+
+#endif
@@ -260,6 +260,7 @@ public:
         return _internals._lookup == rhs_._internals._lookup &&
             _internals._dfa_alphabet == rhs_._internals._dfa_alphabet &&
             _internals._dfa == rhs_._internals._dfa &&
+            _internals._compressed == rhs_._internals._compressed &&
             _internals._seen_BOL_assertion ==
                 rhs_._internals._seen_BOL_assertion &&
             _internals._seen_EOL_assertion ==
@@ -0,0 +1,150 @@
+//  Copyright (c) 2001 Daniel C. Nuffer
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(BOOST_SPIRIT_BUFFERED_ISTREAM_POLICY_OCT_16_2026_1130AM)
+#define BOOST_SPIRIT_BUFFERED_ISTREAM_POLICY_OCT_16_2026_1130AM
+
+#include <boost/spirit/home/support/iterators/multi_pass_fwd.hpp>
+#include <boost/spirit/home/support/iterators/detail/multi_pass.hpp>
+#include <ios>
+#include <vector>
+
+namespace boost { namespace spirit { namespace iterator_policies
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  class buffered_istream
+    //  Implementation of the InputPolicy used by multi_pass
+    //
+    //  The buffered_istream encapsulates an std::basic_istream, reading the
+    //  characters in blocks directly from its stream buffer. Unlike the
+    //  istream policy it doesn't skip whitespace, and it consumes up to
+    //  block_size characters from the stream buffer in advance.
+    //
+    //  A block holds the characters readily available from the stream
+    //  buffer, or a single character if there is none. This way reading
+    //  never waits for more input than required, which is important for
+    //  interactive streams. Note, that std::cin usually has no characters
+    //  readily available as long as it is synchronized with the C streams
+    //  (see std::ios_base::sync_with_stdio).
+    ///////////////////////////////////////////////////////////////////////////
+    struct buffered_istream
+    {
+        enum { block_size = 4096 };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        class unique // : public detail::default_input_policy
+        {
+        private:
+            typedef typename T::char_type result_type;
+
+        public:
+            typedef typename T::off_type difference_type;
+            typedef typename T::off_type distance_type;
+            typedef result_type const* pointer;
+            typedef result_type const& reference;
+            typedef result_type value_type;
+
+        protected:
+            unique() {}
+            explicit unique(T&) {}
+
+            void swap(unique&) {}
+
+        public:
+            template <typename MultiPass>
+            static void destroy(MultiPass&) {}
+
+            template <typename MultiPass>
+            static typename MultiPass::reference get_input(MultiPass& mp)
+            {
+                if (mp.shared()->first_ == mp.shared()->last_)
+                    mp.shared()->read_block();
+                return *mp.shared()->first_;
+            }
+
+            template <typename MultiPass>
+            static void advance_input(MultiPass& mp)
+            {
+                if (mp.shared()->first_ != mp.shared()->last_ ||
+                    mp.shared()->read_block())
+                {
+                    ++mp.shared()->first_;
+                }
+            }
+
+            // test, whether we reached the end of the underlying stream
+            template <typename MultiPass>
+            static bool input_at_eof(MultiPass const& mp)
+            {
+                return mp.shared()->first_ == mp.shared()->last_ &&
+                      !mp.shared()->read_block();
+            }
+
+            template <typename MultiPass>
+            static bool input_is_valid(MultiPass const& mp, value_type const&)
+            {
+                return !input_at_eof(mp);
+            }
+
+            // no unique data elements
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        struct shared
+        {
+        private:
+            typedef typename T::char_type result_type;
+
+        public:
+            explicit shared(T& input)
+              : input_(input), buffer_(block_size)
+            {
+                first_ = last_ = &buffer_[0];
+            }
+
+            // refill the (consumed) buffer, returns false at the end of the
+            // input
+            bool read_block()
+            {
+                std::streamsize count = 0;
+                if (input_.good())
+                {
+                    std::streamsize available = input_.rdbuf()->in_avail();
+                    if (available > std::streamsize(block_size))
+                        available = block_size;
+                    else if (available <= 0)
+                        available = 1;
+                    count = input_.rdbuf()->sgetn(&buffer_[0], available);
+                }
+
+                first_ = &buffer_[0];
+                if (count <= 0)
+                {
+                    last_ = first_;
+                    input_.setstate(std::ios_base::eofbit);
+                    return false;
+                }
+                last_ = first_ + count;
+                return true;
+            }
+
+            T& input_;
+            std::vector<result_type> buffer_;
+            result_type* first_;
+            result_type* last_;
+
+        private:
+            // silence MSVC warning C4512: assignment operator could not be
+            // generated
+            shared& operator= (shared const&);
+        };
+    };
+
+}}}
+
+#endif
@@ -0,0 +1,291 @@
+//  Copyright (c) 2001 Daniel C. Nuffer
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(BOOST_SPIRIT_ITERATOR_CHUNKED_QUEUE_POLICY_OCT_16_2026_1015AM)
+#define BOOST_SPIRIT_ITERATOR_CHUNKED_QUEUE_POLICY_OCT_16_2026_1015AM
+
+#include <boost/spirit/home/support/iterators/multi_pass_fwd.hpp>
+#include <boost/spirit/home/support/iterators/detail/multi_pass.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace boost { namespace spirit { namespace iterator_policies
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  class chunked_queue
+    //
+    //  Implementation of the StoragePolicy used by multi_pass
+    //  This stores the buffered data in a list of chunks holding N elements
+    //  each. Every chunk counts the iterators pointing into it, and the
+    //  chunks in front of the oldest iterator are released as soon as the
+    //  last iterator leaves them (the most recently released chunk is kept
+    //  for reuse). The memory used is thus bounded by the distance between
+    //  the oldest and the foremost iterator, no matter how long copies of
+    //  the iterator are held while parsing proceeds.
+    //
+    //  The chunks are owned by the iterators themselves (and not by the
+    //  shared part of the multi_pass), as only the iterators know when they
+    //  are copied or destroyed. The queue is allocated the first time an
+    //  iterator is used or copied.
+    ///////////////////////////////////////////////////////////////////////////
+    template <std::size_t N>
+    struct chunked_queue
+    {
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Value>
+        class unique //: public detail::default_storage_policy
+        {
+        private:
+            struct chunk
+            {
+                explicit chunk(std::size_t start_)
+                  : start(start_), iterators(0), next(0)
+                {
+                    elements.reserve(N);
+                }
+
+                std::vector<Value> elements;
+                std::size_t start;        // position of the first element
+                std::size_t iterators;    // number of iterators in this chunk
+                chunk* next;
+            };
+
+            struct queue_type
+            {
+                queue_type()
+                  : head(new chunk(0)), spare(0), size(0), iterators(0)
+                {
+                    tail = head;
+                }
+
+                ~queue_type()
+                {
+                    while (head)
+                    {
+                        chunk* next = head->next;
+                        delete head;
+                        head = next;
+                    }
+                    delete spare;
+                }
+
+                // append an element, making sure there is always a chunk
+                // for the position behind the last element
+                void push_back(Value const& val)
+                {
+                    tail->elements.push_back(val);
+                    if (++size == tail->start + N)
+                    {
+                        chunk* c = spare;
+                        if (c)
+                        {
+                            spare = 0;
+                            c->start = size;
+                        }
+                        else
+                        {
+                            c = new chunk(size);
+                        }
+                        tail->next = c;
+                        tail = c;
+                    }
+                }
+
+                // release the chunks no iterator points into anymore
+                void release()
+                {
+                    while (head != tail && head->iterators == 0)
+                    {
+                        chunk* c = head;
+                        head = head->next;
+
+                        c->elements.clear();
+                        c->next = 0;
+                        if (spare)
+                            delete c;
+                        else
+                            spare = c;
+                    }
+                }
+
+            private:
+                // silence MSVC warning C4512: assignment operator could not
+                // be generated
+                queue_type& operator= (queue_type const&);
+                queue_type(queue_type const&);
+
+            public:
+                chunk* head;
+                chunk* tail;
+                chunk* spare;
+                std::size_t size;         // number of elements pushed so far
+                std::size_t iterators;    // number of iterators using it
+            };
+
+        protected:
+            unique() : queue(0), current(0), queued_position(0) {}
+
+            unique(unique const& x)
+              : queue(x.queue), current(x.current)
+              , queued_position(x.queued_position)
+            {
+                if (!queue)
+                {
+                    x.attach();
+                    queue = x.queue;
+                    current = x.current;
+                }
+                ++queue->iterators;
+                ++current->iterators;
+            }
+
+            ~unique()
+            {
+                if (queue)
+                {
+                    leave(current);
+                    if (--queue->iterators == 0)
+                        delete queue;
+                }
+            }
+
+            void swap(unique& x)
+            {
+                boost::swap(queue, x.queue);
+                boost::swap(current, x.current);
+                boost::swap(queued_position, x.queued_position);
+            }
+
+            // This is called when the iterator is dereferenced.  It's a
+            // template method so we can recover the type of the multi_pass
+            // iterator and call get_input.
+            template <typename MultiPass>
+            static typename MultiPass::reference
+            dereference(MultiPass const& mp)
+            {
+                if (!mp.queue || mp.queued_position == mp.queue->size)
+                    return MultiPass::get_input(mp);
+
+                BOOST_ASSERT(mp.queued_position < mp.queue->size);
+                return mp.current->elements[
+                    mp.queued_position - mp.current->start];
+            }
+
+            // This is called when the iterator is incremented. It's a template
+            // method so we can recover the type of the multi_pass iterator
+            // and call is_unique and advance_input.
+            template <typename MultiPass>
+            static void increment(MultiPass& mp)
+            {
+                if (!mp.queue)
+                    mp.attach();
+
+                BOOST_ASSERT(mp.queued_position <= mp.queue->size);
+
+                if (mp.queued_position == mp.queue->size)
+                {
+                    // the only iterator doesn't need to store anything, all
+                    // chunks but the current one are released already
+                    if (!MultiPass::is_unique(mp))
+                    {
+                        mp.queue->push_back(MultiPass::get_input(mp));
+                        mp.advance();
+                    }
+                    MultiPass::advance_input(mp);
+                }
+                else
+                {
+                    mp.advance();
+                }
+            }
+
+            // called to forcibly clear the queue, the chunks are released
+            // once the other iterators leave them
+            template <typename MultiPass>
+            static void clear_queue(MultiPass& mp)
+            {
+                if (!mp.queue)
+                    return;
+
+                mp.queued_position = mp.queue->size;
+                if (mp.current != mp.queue->tail)
+                {
+                    ++mp.queue->tail->iterators;
+                    mp.leave(mp.current);
+                    mp.current = mp.queue->tail;
+                }
+            }
+
+            // called to determine whether the iterator is an eof iterator
+            template <typename MultiPass>
+            static bool is_eof(MultiPass const& mp)
+            {
+                return (!mp.queue || mp.queued_position == mp.queue->size)
+                    && MultiPass::input_at_eof(mp);
+            }
+
+            // called by operator==
+            template <typename MultiPass>
+            static bool equal_to(MultiPass const& mp, MultiPass const& x)
+            {
+                return mp.queued_position == x.queued_position;
+            }
+
+            // called by operator<
+            template <typename MultiPass>
+            static bool less_than(MultiPass const& mp, MultiPass const& x)
+            {
+                return mp.queued_position < x.queued_position;
+            }
+
+            template <typename MultiPass>
+            static void destroy(MultiPass&) {}
+
+        private:
+            // allocate the queue on first use, the input hasn't been
+            // advanced before
+            void attach() const
+            {
+                queue = new queue_type;
+                current = queue->head;
+                ++queue->iterators;
+                ++current->iterators;
+            }
+
+            // move to the next position, entering the next chunk if needed
+            void advance() const
+            {
+                if (++queued_position == current->start + N)
+                {
+                    chunk* c = current;
+                    current = c->next;
+                    ++current->iterators;
+                    leave(c);
+                }
+            }
+
+            void leave(chunk* c) const
+            {
+                if (--c->iterators == 0 && c == queue->head)
+                    queue->release();
+            }
+
+        protected:
+            mutable queue_type* queue;
+            mutable chunk* current;
+            mutable std::size_t queued_position;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Value>
+        struct shared {};
+
+    }; // chunked_queue
+
+}}}
+
+#endif
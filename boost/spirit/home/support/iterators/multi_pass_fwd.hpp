@@ -21,6 +21,7 @@ namespace boost { namespace spirit {
         struct input_iterator;
         struct buffering_input_iterator;
         struct istream;
+        struct buffered_istream;
         struct lex_input;
         struct functor_input;
         struct split_functor_input;
@@ -37,6 +38,7 @@ namespace boost { namespace spirit {
         // storage policies
         struct split_std_deque;
         template<std::size_t N> struct fixed_size_queue;
+        template<std::size_t N> struct chunked_queue;
 
         // policy combiner
 #if defined(BOOST_SPIRIT_DEBUG)
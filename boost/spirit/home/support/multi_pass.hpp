@@ -19,6 +19,7 @@
 #include <boost/spirit/home/support/iterators/detail/input_iterator_policy.hpp>
 #include <boost/spirit/home/support/iterators/detail/buffering_input_iterator_policy.hpp>
 #include <boost/spirit/home/support/iterators/detail/istream_policy.hpp>
+#include <boost/spirit/home/support/iterators/detail/buffered_istream_policy.hpp>
 #include <boost/spirit/home/support/iterators/detail/lex_input_policy.hpp>
 #include <boost/spirit/home/support/iterators/detail/split_functor_input_policy.hpp>
 #include <boost/spirit/home/support/iterators/detail/functor_input_policy.hpp>
@@ -30,6 +31,7 @@
 //  Storage policies
 #include <boost/spirit/home/support/iterators/detail/fixed_size_queue_policy.hpp>
 #include <boost/spirit/home/support/iterators/detail/split_std_deque_policy.hpp>
+#include <boost/spirit/home/support/iterators/detail/chunked_queue_policy.hpp>
 
 //  Main multi_pass iterator 
 #include <boost/spirit/home/support/iterators/detail/combine_policies.hpp>
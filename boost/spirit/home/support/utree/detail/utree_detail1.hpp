@@ -47,10 +47,21 @@ namespace boost { namespace spirit { namespace detail
         template <typename T>
         void push_back(T const& val);
 
+        template <typename T>
+        static node* new_node(T const& val, node* next, node* prev);
+        static void delete_node(node* p);
+
         void pop_front();
         void pop_back();
         node* erase(node* pos);
 
+        // lists of at least this many elements keep an index of their nodes
+        enum { index_threshold = 16 };
+
+        node* at(std::size_t i) const;
+        void check_index();
+        void drop_index();
+
         node* first;
         node* last;
         std::size_t size;
@@ -93,8 +104,9 @@ namespace boost { namespace spirit { namespace detail
     // management info.
     //
     // It is a const string (i.e. immutable). It stores the characters directly
-    // if possible and only uses the heap if the string does not fit. Null
-    // characters are allowed, making it suitable to encode raw binary. The
+    // if possible and only uses the heap (or the current utree_arena) if the
+    // string does not fit. Null characters are allowed, making it suitable
+    // to encode raw binary. The
     // string length is encoded in the first byte if the string is placed in-situ,
     // else, the length plus a pointer to the string in the heap are stored.
     ///////////////////////////////////////////////////////////////////////////
@@ -126,6 +138,7 @@ namespace boost { namespace spirit { namespace detail
         int get_type() const;
         void set_type(int t);
         bool is_heap_allocated() const;
+        bool is_arena_allocated() const;
 
         std::size_t size() const;
         char const* str() const;
@@ -18,6 +18,12 @@
 #include <boost/utility/enable_if.hpp>
 #include <boost/throw_exception.hpp>
 #include <boost/iterator/iterator_traits.hpp>
+#include <deque>
+#include <new>
+
+#if defined(BOOST_SPIRIT_THREADSAFE)
+#include <boost/thread/tss.hpp>
+#endif
 
 namespace boost { namespace spirit { namespace detail
 {
@@ -31,14 +37,16 @@ namespace boost { namespace spirit { namespace detail
         return buff[small_string_size];
     }
 
+    // The info byte holds the heap flag (bit 0), the type (bits 1 to 4)
+    // and the arena flag (bit 5).
     inline int fast_string::get_type() const
     {
-        return info() >> 1;
+        return (info() >> 1) & 0xf;
     }
 
     inline void fast_string::set_type(int t)
     {
-        info() = (t << 1) | (info() & 1);
+        info() = (t << 1) | (info() & 0x21);
     }
 
     inline short fast_string::tag() const
@@ -61,6 +69,11 @@ namespace boost { namespace spirit { namespace detail
         return info() & 1;
     }
 
+    inline bool fast_string::is_arena_allocated() const
+    {
+        return (info() & 0x20) != 0;
+    }
+
     inline std::size_t fast_string::size() const
     {
         if (is_heap_allocated())
@@ -88,7 +101,15 @@ namespace boost { namespace spirit { namespace detail
             // of the string is placed in buff[small_string_size - 1]
             str = buff;
             buff[small_string_size - 1] = static_cast<char>(max_string_len - size);
-            info() &= ~0x1;
+            info() &= ~0x21;
+        }
+        else if (utree_arena* arena = utree_arena::current())
+        {
+            // else, store it in the current arena
+            str = static_cast<char*>(arena->allocate(size + 1));
+            heap.str = str;
+            heap.size = size;
+            info() |= 0x21;
         }
         else
         {
@@ -96,7 +117,7 @@ namespace boost { namespace spirit { namespace detail
             str = new char[size + 1]; // add one for the null char
             heap.str = str;
             heap.size = size;
-            info() |= 0x1;
+            info() = (info() | 0x1) & ~0x20;
         }
         for (std::size_t i = 0; i != size; ++i)
         {
@@ -112,7 +133,8 @@ namespace boost { namespace spirit { namespace detail
 
     inline void fast_string::free()
     {
-        if (is_heap_allocated())
+        // strings allocated from an arena are released by the arena
+        if (is_heap_allocated() && !is_arena_allocated())
         {
             delete [] heap.str;
         }
@@ -131,9 +153,11 @@ namespace boost { namespace spirit { namespace detail
 
     struct list::node : boost::noncopyable
     {
+        typedef std::deque<node*> index_type;
+
         template <typename T>
         node(T const& val, node* next, node* prev)
-          : val(val), next(next), prev(prev) {}
+          : val(val), next(next), prev(prev), aux(0) {}
 
         void unlink()
         {
@@ -141,9 +165,34 @@ namespace boost { namespace spirit { namespace detail
             next->prev = prev;
         }
 
+        bool is_arena_allocated() const
+        {
+            return (aux & 1) != 0;
+        }
+
+        void set_arena_allocated()
+        {
+            aux |= 1;
+        }
+
+        index_type* index() const
+        {
+            return reinterpret_cast<index_type*>(aux & ~std::size_t(1));
+        }
+
+        void index(index_type* p)
+        {
+            aux = reinterpret_cast<std::size_t>(p) | (aux & 1);
+        }
+
         utree val;
         node* next;
         node* prev;
+
+        // Bit 0 is set if the node was allocated from an utree_arena, the
+        // other bits hold the index of all nodes of the list (if any, and
+        // for the first node only).
+        std::size_t aux;
     };
 
     template <typename Value>
@@ -260,13 +309,35 @@ namespace boost { namespace spirit { namespace detail
     template <typename Value>
     Value list::node_iterator<boost::reference_wrapper<Value> >::nil_node = Value();
 
+    template <typename T>
+    inline list::node* list::new_node(T const& val, node* next, node* prev)
+    {
+        if (utree_arena* arena = utree_arena::current())
+        {
+            node* p = new (arena->allocate(sizeof(node))) node(val, next, prev);
+            p->set_arena_allocated();
+            return p;
+        }
+        return new node(val, next, prev);
+    }
+
+    inline void list::delete_node(node* p)
+    {
+        // nodes allocated from an arena are released by the arena
+        if (p->is_arena_allocated())
+            p->~node();
+        else
+            delete p;
+    }
+
     inline void list::free()
     {
+        drop_index();
         node* p = first;
         while (p != 0)
         {
             node* next = p->next;
-            delete p;
+            delete_node(p);
             p = next;
         }
     }
@@ -296,8 +367,15 @@ namespace boost { namespace spirit { namespace detail
             return;
         }
 
+        if (pos.node == first)
+        {
+            push_front(val);
+            return;
+        }
+
+        drop_index();
         detail::list::node* new_node = 
-            new detail::list::node(val, pos.node, pos.node->prev);
+            list::new_node(val, pos.node, pos.node->prev);
 
         if (pos.node->prev)
             pos.node->prev->next = new_node;
@@ -314,17 +392,28 @@ namespace boost { namespace spirit { namespace detail
         detail::list::node* new_node;
         if (first == 0)
         {
-            new_node = new detail::list::node(val, 0, 0);
+            new_node = list::new_node(val, 0, 0);
             first = last = new_node;
             ++size;
         }
         else
         {
-            new_node = new detail::list::node(val, first, first->prev);
+            new_node = list::new_node(val, first, first->prev);
+
+            // the index (if any) moves to the new first node
+            node::index_type* index = first->index();
+            first->index(0);
             first->prev = new_node;
             first = new_node;
             ++size;
+
+            if (index)
+            {
+                first->index(index);
+                index->push_front(new_node);
+            }
         }
+        check_index();
     }
 
     template <typename T>
@@ -334,10 +423,15 @@ namespace boost { namespace spirit { namespace detail
             push_front(val);
         else {
             detail::list::node* new_node = 
-                new detail::list::node(val, last->next, last);
+                list::new_node(val, last->next, last);
             last->next = new_node;
             last = new_node;
             ++size;
+
+            if (node::index_type* index = first->index())
+                index->push_back(new_node);
+            else
+                check_index();
         }
     }
 
@@ -346,17 +440,27 @@ namespace boost { namespace spirit { namespace detail
         BOOST_ASSERT(size != 0);
         if (first == last) // there's only one item
         {
-            delete first;
+            drop_index();
+            delete_node(first);
             size = 0;
             first = last = 0;
         }
         else
         {
             node* np = first;
+            node::index_type* index = np->index();
+            np->index(0);
             first = first->next;
             first->prev = 0;
-            delete np;
+            delete_node(np);
             --size;
+
+            // the index (if any) moves to the new first node
+            if (index)
+            {
+                index->pop_front();
+                first->index(index);
+            }
         }
     }
 
@@ -365,7 +469,8 @@ namespace boost { namespace spirit { namespace detail
         BOOST_ASSERT(size != 0);
         if (first == last) // there's only one item
         {
-            delete first;
+            drop_index();
+            delete_node(first);
             size = 0;
             first = last = 0;
         }
@@ -374,8 +479,11 @@ namespace boost { namespace spirit { namespace detail
             node* np = last;
             last = last->prev;
             last->next = 0;
-            delete np;
+            delete_node(np);
             --size;
+
+            if (node::index_type* index = first->index())
+                index->pop_back();
         }
     }
 
@@ -394,14 +502,72 @@ namespace boost { namespace spirit { namespace detail
         }
         else
         {
+            drop_index();
             node* next(pos->next);
             pos->unlink();
-            delete pos;
+            delete_node(pos);
             --size;
             return next;
         }
     }
 
+    // Elements close to either end of the list are reached by walking the
+    // list, all others through the index of the list nodes, if there is
+    // one. The index is kept up to date by the modifying functions only (see
+    // check_index), so reading a list never modifies it and concurrent
+    // reads of the same list are safe.
+    inline list::node* list::at(std::size_t i) const
+    {
+        BOOST_ASSERT(i < size);
+        if (i >= index_threshold && size - i > index_threshold)
+        {
+            if (node::index_type const* index = first->index())
+                return (*index)[i];
+        }
+
+        node* p = 0;
+        if (i < size / 2)
+        {
+            for (p = first; i > 0; --i)
+                p = p->next;
+        }
+        else
+        {
+            for (p = last, i = size - 1 - i; i > 0; --i)
+                p = p->prev;
+        }
+        return p;
+    }
+
+    // Called after adding an element to either end of the list. The index
+    // is built when the list reaches index_threshold elements and is then
+    // maintained by push_front, push_back, pop_front and pop_back. Inserting
+    // or erasing elements in the middle of the list drops it, in which case
+    // it is only rebuilt when the size of the list reaches the next power of
+    // two, so that rebuilding it takes amortized constant time.
+    inline void list::check_index()
+    {
+        if (size < index_threshold || (size & (size - 1)) != 0 ||
+            first->index() != 0)
+        {
+            return;
+        }
+
+        node::index_type* index = new node::index_type;
+        for (node* p = first; p != 0; p = p->next)
+            index->push_back(p);
+        first->index(index);
+    }
+
+    inline void list::drop_index()
+    {
+        if (first != 0)
+        {
+            delete first->index();
+            first->index(0);
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // simple binder for binary visitation (we don't want to bring in the big guns)
     template <typename F, typename X>
@@ -596,6 +762,91 @@ namespace boost { namespace spirit { namespace detail
 
 namespace boost { namespace spirit
 {
+    inline utree_arena::utree_arena(std::size_t block_size)
+      : blocks(0), first(0), last(0), block_size(block_size), allocated(0)
+    {
+    }
+
+    inline utree_arena::~utree_arena()
+    {
+        while (blocks != 0)
+        {
+            block* next = blocks->next;
+            delete [] reinterpret_cast<char*>(blocks);
+            blocks = next;
+        }
+    }
+
+    inline void* utree_arena::allocate(std::size_t size)
+    {
+        std::size_t const align =
+            boost::alignment_of<detail::list::node>::value;
+        size = (size + align - 1) & ~(align - 1);
+
+        if (size > std::size_t(last - first))
+        {
+            // large allocations get a block of their own, leaving the
+            // current block in place
+            if (size > block_size / 4)
+                return new_block(size);
+
+            first = new_block(block_size);
+            last = first + block_size;
+        }
+
+        void* p = first;
+        first += size;
+        return p;
+    }
+
+    inline std::size_t utree_arena::capacity() const
+    {
+        return allocated;
+    }
+
+    inline char* utree_arena::new_block(std::size_t size)
+    {
+        std::size_t const align =
+            boost::alignment_of<detail::list::node>::value;
+        std::size_t const header = (sizeof(block) + align - 1) & ~(align - 1);
+
+        char* p = new char[header + size];
+        block* b = reinterpret_cast<block*>(p);
+        b->next = blocks;
+        blocks = b;
+        allocated += header + size;
+        return p + header;
+    }
+
+    inline utree_arena*& utree_arena::current_arena()
+    {
+#if defined(BOOST_SPIRIT_THREADSAFE)
+        static boost::thread_specific_ptr<utree_arena*> arena;
+        if (!arena.get())
+            arena.reset(new utree_arena*(0));
+        return *arena;
+#else
+        static utree_arena* arena = 0;
+        return arena;
+#endif
+    }
+
+    inline utree_arena* utree_arena::current()
+    {
+        return current_arena();
+    }
+
+    inline utree_arena::scope::scope(utree_arena& arena)
+      : outer(current_arena())
+    {
+        current_arena() = &arena;
+    }
+
+    inline utree_arena::scope::~scope()
+    {
+        current_arena() = outer;
+    }
+
     template <typename F>
     stored_function<F>::stored_function(F f)
       : f(f)
@@ -933,7 +1184,7 @@ namespace boost { namespace spirit
         if (get_type() != type::list_type || size() <= i)
             boost::throw_exception(bad_type_exception());
 
-        return detail::index_impl::apply(l.first, i);
+        return l.at(i)->val;
     }
 
     inline utree const& utree::operator[](std::size_t i) const
@@ -947,7 +1198,7 @@ namespace boost { namespace spirit
         if (get_type() != type::list_type || size() <= i)
             boost::throw_exception(bad_type_exception());
 
-        return detail::index_impl::apply(l.first, i);
+        return l.at(i)->val;
     }
 
     template <typename T>
@@ -201,6 +201,62 @@ namespace boost { namespace spirit
     struct shallow_tag {};
     shallow_tag const shallow = {};
 
+    //[utree_arena
+    /*`An `utree_arena` is a monotonic memory resource for the list nodes and 
+       the heap allocated strings of `utree` instances. While an 
+       `utree_arena::scope` is alive, all of these are allocated (on the 
+       current thread) from the arena of the innermost scope, which carves 
+       them out of large blocks. Destroying an `utree` does not release 
+       memory allocated from an arena, all blocks are released at once by the 
+       destructor of the arena instead. The arena has to outlive all `utree` 
+       instances allocating from it.
+    */
+    class utree_arena : boost::noncopyable
+    {
+    public:
+        explicit utree_arena(std::size_t block_size = 64 * 1024);
+        ~utree_arena();
+
+        // allocate size bytes, aligned suitably for any utree data
+        void* allocate(std::size_t size);
+
+        // the number of bytes allocated from the heap so far
+        std::size_t capacity() const;
+
+        // the arena of the innermost scope (if any)
+        static utree_arena* current();
+
+        class scope : boost::noncopyable
+        {
+        public:
+            explicit scope(utree_arena& arena);
+            ~scope();
+
+        //<-
+        private:
+            utree_arena* outer;
+        //->
+        };
+
+    //<-
+    private:
+        struct block
+        {
+            block* next;
+        };
+
+        static utree_arena*& current_arena();
+        char* new_block(std::size_t size);
+
+        block* blocks;
+        char* first;            // the free space of the current block
+        char* last;
+        std::size_t block_size;
+        std::size_t allocated;
+    //->
+    };
+    //]
+
     ///////////////////////////////////////////////////////////////////////////
     // A void* plus type_info
     ///////////////////////////////////////////////////////////////////////////
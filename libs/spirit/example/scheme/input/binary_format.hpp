@@ -0,0 +1,52 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//  Copyright (c) 2001-2011 Joel de Guzman
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(SCHEME_BINARY_FORMAT_OCT_16_2026_0915AM)
+#define SCHEME_BINARY_FORMAT_OCT_16_2026_0915AM
+
+namespace scheme { namespace binary_format
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  The binary representation of an utree starts with the magic bytes
+    //  'U' 'T' 'R' 'B' and the format version, followed by the encoded
+    //  utree. Every node is a tag byte followed by its data:
+    //
+    //      nil, true, false        -
+    //      integer                 zig-zag encoded varint
+    //      real                    8 bytes, IEEE 754, little endian
+    //      string, binary          varint length, bytes
+    //      symbol                  varint length, bytes (the first time
+    //                              a symbol is written)
+    //      symbol_ref              varint index of a symbol written before
+    //      list_begin              elements, list_end
+    //      tagged                  zig-zag encoded varint utree tag (e.g.
+    //                              the source line), the tagged node
+    //
+    //  Varints are stored in little endian groups of 7 bits, the high bit
+    //  of each byte marks that more bytes follow.
+    ///////////////////////////////////////////////////////////////////////////
+    char const magic[] = { 'U', 'T', 'R', 'B' };
+    unsigned char const version = 1;
+
+    enum tag
+    {
+        invalid = 0,
+        nil,
+        false_,
+        true_,
+        integer,
+        real,
+        string,
+        symbol,
+        symbol_ref,
+        binary,
+        list_begin,
+        list_end,
+        tagged
+    };
+}}
+
+#endif
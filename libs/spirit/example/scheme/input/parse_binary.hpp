@@ -0,0 +1,304 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//  Copyright (c) 2001-2011 Joel de Guzman
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(SCHEME_INPUT_PARSE_BINARY_OCT_16_2026_0915AM)
+#define SCHEME_INPUT_PARSE_BINARY_OCT_16_2026_0915AM
+
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/spirit/include/support_utree.hpp>
+
+#include <input/binary_format.hpp>
+
+namespace scheme { namespace input
+{
+    using boost::spirit::utree;
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        //  Reads the binary representation (see input/binary_format.hpp) of
+        //  utree nodes from a contiguous buffer. If shallow is true, strings
+        //  are not copied but refer to the buffer directly.
+        ///////////////////////////////////////////////////////////////////////
+        class binary_parser
+        {
+        public:
+            binary_parser(char const* first, char const* last, bool shallow)
+              : first(first), last(last), shallow(shallow) {}
+
+            bool parse(utree& ut)
+            {
+                unsigned char t;
+                if (!get(t))
+                    return false;
+
+                bool const tagged = (t == binary_format::tagged);
+                int tag = 0;
+                if (tagged)
+                {
+                    if (!get_int(tag) ||
+                        tag < (std::numeric_limits<short>::min)() ||
+                        tag > (std::numeric_limits<short>::max)() ||
+                        !get(t) || t == binary_format::tagged)
+                    {
+                        return false;
+                    }
+                }
+
+                if (!parse_node(t, ut))
+                    return false;
+
+                if (tagged)
+                {
+                    // strings, symbols and binary data can't have a tag
+                    switch (ut.which())
+                    {
+                        case boost::spirit::utree_type::string_type:
+                        case boost::spirit::utree_type::symbol_type:
+                        case boost::spirit::utree_type::binary_type:
+                            return false;
+
+                        default:
+                            ut.tag(short(tag));
+                            break;
+                    }
+                }
+                return true;
+            }
+
+            bool at_end() const
+            {
+                return first == last;
+            }
+
+        private:
+            bool parse_node(unsigned char t, utree& ut)
+            {
+                using boost::spirit::utf8_string_range_type;
+                using boost::spirit::utf8_symbol_range_type;
+                using boost::spirit::binary_range_type;
+
+                switch (t)
+                {
+                    case binary_format::invalid:
+                        ut = utree();
+                        return true;
+
+                    case binary_format::nil:
+                        ut = boost::spirit::nil;
+                        return true;
+
+                    case binary_format::false_:
+                    case binary_format::true_:
+                        ut = (t == binary_format::true_);
+                        return true;
+
+                    case binary_format::integer:
+                    {
+                        int i;
+                        if (!get_int(i))
+                            return false;
+                        ut = i;
+                        return true;
+                    }
+
+                    case binary_format::real:
+                    {
+                        if (last - first < 8)
+                            return false;
+
+                        boost::uint64_t bits = 0;
+                        for (int i = 7; i >= 0; --i)
+                            bits = (bits << 8) | (unsigned char)first[i];
+                        first += 8;
+
+                        double d;
+                        std::memcpy(&d, &bits, sizeof(d));
+                        ut = d;
+                        return true;
+                    }
+
+                    case binary_format::string:
+                    {
+                        char const* str;
+                        std::size_t size;
+                        if (!get_bytes(str, size))
+                            return false;
+
+                        if (shallow)
+                            ut = utree(utf8_string_range_type(str, size), boost::spirit::shallow);
+                        else
+                            ut = utf8_string_range_type(str, size);
+                        return true;
+                    }
+
+                    case binary_format::symbol:
+                    {
+                        char const* str;
+                        std::size_t size;
+                        if (!get_bytes(str, size))
+                            return false;
+
+                        symbols.push_back(utf8_symbol_range_type(str, size));
+                        ut = symbols.back();
+                        return true;
+                    }
+
+                    case binary_format::symbol_ref:
+                    {
+                        boost::uint64_t index;
+                        if (!get_varint(index) || index >= symbols.size())
+                            return false;
+
+                        ut = symbols[std::size_t(index)];
+                        return true;
+                    }
+
+                    case binary_format::binary:
+                    {
+                        char const* str;
+                        std::size_t size;
+                        if (!get_bytes(str, size))
+                            return false;
+
+                        ut = binary_range_type(str, size);
+                        return true;
+                    }
+
+                    case binary_format::list_begin:
+                    {
+                        ut = boost::spirit::empty_list;
+                        for (;;)
+                        {
+                            if (first == last)
+                                return false;
+
+                            if ((unsigned char)*first == binary_format::list_end)
+                            {
+                                ++first;
+                                return true;
+                            }
+
+                            // parse the element in place, avoiding to copy
+                            // nested lists
+                            ut.push_back(utree());
+                            if (!parse(ut.back()))
+                                return false;
+                        }
+                    }
+
+                    default:
+                        break;
+                }
+                return false;
+            }
+
+            bool get(unsigned char& c)
+            {
+                if (first == last)
+                    return false;
+                c = (unsigned char)*first++;
+                return true;
+            }
+
+            bool get_varint(boost::uint64_t& v)
+            {
+                v = 0;
+                for (int shift = 0; shift < 64; shift += 7)
+                {
+                    unsigned char c;
+                    if (!get(c))
+                        return false;
+
+                    v |= boost::uint64_t(c & 0x7f) << shift;
+                    if (!(c & 0x80))
+                        return true;
+                }
+                return false;
+            }
+
+            bool get_int(int& i)
+            {
+                boost::uint64_t v;
+                if (!get_varint(v))
+                    return false;
+
+                boost::int64_t const value =
+                    boost::int64_t(v >> 1) ^ -boost::int64_t(v & 1);
+                if (value < (std::numeric_limits<int>::min)() ||
+                    value > (std::numeric_limits<int>::max)())
+                {
+                    return false;
+                }
+
+                i = int(value);
+                return true;
+            }
+
+            bool get_bytes(char const*& str, std::size_t& size)
+            {
+                boost::uint64_t v;
+                if (!get_varint(v) || v > boost::uint64_t(last - first))
+                    return false;
+
+                str = first;
+                size = std::size_t(v);
+                first += size;
+                return true;
+            }
+
+            char const* first;
+            char const* last;
+            bool shallow;
+            std::vector<boost::spirit::utf8_symbol_range_type> symbols;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  Parse the binary representation of an utree (as written by
+    //  output::generate_binary) from the buffer [first, last), which may
+    //  very well be a memory mapped file. If shallow is true, all strings
+    //  in the result refer to the buffer instead of being copied, which
+    //  requires the buffer to outlive the result (symbols and binary data
+    //  are copied always).
+    inline bool parse_binary(
+        char const* first,
+        char const* last,
+        utree& result,
+        bool shallow = false)
+    {
+        std::size_t const header_size = sizeof(binary_format::magic) + 1;
+        if (std::size_t(last - first) < header_size ||
+            std::memcmp(first, binary_format::magic,
+                sizeof(binary_format::magic)) != 0 ||
+            (unsigned char)first[header_size-1] != binary_format::version)
+        {
+            return false;
+        }
+
+        detail::binary_parser p(first + header_size, last, shallow);
+        return p.parse(result) && p.at_end();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    inline bool parse_binary(std::istream& is, utree& result)
+    {
+        std::string buffer(
+            (std::istreambuf_iterator<char>(is)),
+            std::istreambuf_iterator<char>());
+        return parse_binary(
+            buffer.data(), buffer.data() + buffer.size(), result);
+    }
+}}
+
+#endif
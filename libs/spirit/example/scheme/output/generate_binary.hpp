@@ -0,0 +1,214 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//  Copyright (c) 2001-2011 Joel de Guzman
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(SCHEME_OUTPUT_GENERATE_BINARY_OCT_16_2026_0915AM)
+#define SCHEME_OUTPUT_GENERATE_BINARY_OCT_16_2026_0915AM
+
+#include <cstring>
+#include <map>
+#include <ostream>
+#include <string>
+
+#include <boost/cstdint.hpp>
+#include <boost/spirit/include/support_utree.hpp>
+
+#include <input/binary_format.hpp>
+
+namespace scheme { namespace output
+{
+    using boost::spirit::utree;
+    using boost::spirit::utree_type;
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        //  Writes the binary representation (see input/binary_format.hpp) of
+        //  utree nodes, remembering the symbols written so far.
+        ///////////////////////////////////////////////////////////////////////
+        class binary_generator
+        {
+        public:
+            binary_generator(std::string& out)
+              : out(out) {}
+
+            bool generate(utree const& ut)
+            {
+                // strings, symbols and binary data don't have a tag
+                switch (ut.which())
+                {
+                    case utree_type::string_type:
+                    case utree_type::symbol_type:
+                    case utree_type::binary_type:
+                        break;
+
+                    default:
+                        if (int const tag = ut.tag())
+                        {
+                            put(binary_format::tagged);
+                            put_varint(zigzag(tag));
+                        }
+                        break;
+                }
+                return utree::visit(ut, visitor(*this));
+            }
+
+        private:
+            struct visitor
+            {
+                typedef bool result_type;
+
+                visitor(binary_generator& g) : g(g) {}
+
+                bool operator()(utree::invalid_type) const
+                {
+                    return g.put(binary_format::invalid);
+                }
+
+                bool operator()(utree::nil_type) const
+                {
+                    return g.put(binary_format::nil);
+                }
+
+                bool operator()(bool b) const
+                {
+                    return g.put(b ? binary_format::true_ : binary_format::false_);
+                }
+
+                bool operator()(int i) const
+                {
+                    g.put(binary_format::integer);
+                    return g.put_varint(zigzag(i));
+                }
+
+                bool operator()(double d) const
+                {
+                    boost::uint64_t bits;
+                    std::memcpy(&bits, &d, sizeof(bits));
+
+                    g.put(binary_format::real);
+                    for (int i = 0; i != 8; ++i, bits >>= 8)
+                        g.out += char(bits & 0xff);
+                    return true;
+                }
+
+                bool operator()(boost::spirit::utf8_string_range_type const& str) const
+                {
+                    g.put(binary_format::string);
+                    return g.put_bytes(str.begin(), str.end());
+                }
+
+                bool operator()(boost::spirit::utf8_symbol_range_type const& str) const
+                {
+                    std::string const name(str.begin(), str.end());
+                    std::map<std::string, std::size_t>::iterator it =
+                        g.symbols.find(name);
+                    if (it != g.symbols.end())
+                    {
+                        g.put(binary_format::symbol_ref);
+                        return g.put_varint(it->second);
+                    }
+
+                    std::size_t const index = g.symbols.size();
+                    g.symbols.insert(std::make_pair(name, index));
+                    g.put(binary_format::symbol);
+                    return g.put_bytes(str.begin(), str.end());
+                }
+
+                bool operator()(boost::spirit::binary_range_type const& bin) const
+                {
+                    g.put(binary_format::binary);
+                    return g.put_bytes(bin.begin(), bin.end());
+                }
+
+                template <typename Iterator>
+                bool operator()(boost::iterator_range<Iterator> const& range) const
+                {
+                    typedef typename
+                        boost::iterator_range<Iterator>::const_iterator
+                    iterator;
+
+                    g.put(binary_format::list_begin);
+                    for (iterator i = range.begin(); i != range.end(); ++i)
+                    {
+                        if (!g.generate(*i))
+                            return false;
+                    }
+                    return g.put(binary_format::list_end);
+                }
+
+                // pointers and functions can't be stored
+                bool operator()(boost::spirit::any_ptr const&) const
+                {
+                    return false;
+                }
+
+                bool operator()(boost::spirit::function_base const&) const
+                {
+                    return false;
+                }
+
+                binary_generator& g;
+
+            private:
+                // silence MSVC warning C4512: assignment operator could not be generated
+                visitor& operator= (visitor const&);
+            };
+
+            static boost::uint64_t zigzag(int i)
+            {
+                boost::int64_t const v = i;
+                return (boost::uint64_t(v) << 1) ^ boost::uint64_t(v >> 63);
+            }
+
+            bool put(int tag)
+            {
+                out += char(tag);
+                return true;
+            }
+
+            bool put_varint(boost::uint64_t v)
+            {
+                for (/**/; v >= 0x80; v >>= 7)
+                    out += char((v & 0x7f) | 0x80);
+                out += char(v);
+                return true;
+            }
+
+            bool put_bytes(char const* first, char const* last)
+            {
+                put_varint(last - first);
+                out.append(first, last);
+                return true;
+            }
+
+            std::string& out;
+            std::map<std::string, std::size_t> symbols;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  Append the binary representation of tree to str. Returns false if
+    //  the tree holds nodes which can't be stored (pointers or functions).
+    inline bool generate_binary(std::string& str, utree const& tree)
+    {
+        str.append(binary_format::magic, sizeof(binary_format::magic));
+        str += char(binary_format::version);
+
+        detail::binary_generator g(str);
+        return g.generate(tree);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    inline bool generate_binary(std::ostream& os, utree const& tree)
+    {
+        std::string str;
+        if (!generate_binary(str, tree))
+            return false;
+        return os.write(str.data(), str.size()).good();
+    }
+}}
+
+#endif
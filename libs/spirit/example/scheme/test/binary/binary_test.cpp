@@ -0,0 +1,179 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//  Copyright (c) 2001-2011 Joel de Guzman
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/config/warning_disable.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#include <input/parse_binary.hpp>
+#include <output/generate_binary.hpp>
+
+#include <sstream>
+#include <string>
+
+using boost::spirit::utree;
+
+///////////////////////////////////////////////////////////////////////////////
+bool round_trip(utree const& val, bool shallow = false)
+{
+    std::string buffer;
+    if (!scheme::output::generate_binary(buffer, val))
+        return false;
+
+    utree result;
+    if (!scheme::input::parse_binary(buffer.data()
+          , buffer.data() + buffer.size(), result, shallow))
+    {
+        return false;
+    }
+    return result == val;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    using boost::spirit::utf8_string_type;
+    using boost::spirit::utf8_string_range_type;
+    using boost::spirit::utf8_symbol_type;
+    using boost::spirit::binary_string_type;
+    using boost::spirit::utree_type;
+
+    {
+        BOOST_TEST(round_trip(utree()));
+        BOOST_TEST(round_trip(utree(boost::spirit::nil)));
+        BOOST_TEST(round_trip(utree(true)));
+        BOOST_TEST(round_trip(utree(false)));
+        BOOST_TEST(round_trip(utree(0)));
+        BOOST_TEST(round_trip(utree(63)));
+        BOOST_TEST(round_trip(utree(-64)));
+        BOOST_TEST(round_trip(utree(123456789)));
+        BOOST_TEST(round_trip(utree((std::numeric_limits<int>::max)())));
+        BOOST_TEST(round_trip(utree((std::numeric_limits<int>::min)())));
+        BOOST_TEST(round_trip(utree(3.14159)));
+        BOOST_TEST(round_trip(utree(-1e300)));
+        BOOST_TEST(round_trip(utree("")));
+        BOOST_TEST(round_trip(utree("a string longer than the small string buffer")));
+        BOOST_TEST(round_trip(utree(utf8_symbol_type("define"))));
+        BOOST_TEST(round_trip(utree(binary_string_type(std::string("\0\1\2", 3)))));
+        BOOST_TEST(round_trip(utree::list_type()));
+    }
+
+    {
+        utree val;
+        val.push_back(utf8_symbol_type("define"));
+        val.push_back(utf8_symbol_type("x"));
+        val.tag(42);
+
+        utree item;
+        item.push_back(utf8_symbol_type("+"));
+        item.push_back(utf8_symbol_type("x"));
+        item.push_back(1.5);
+        item.push_back("text");
+        item.tag(-7);
+        val.push_back(item);
+        val.push_back(utree::list_type());
+
+        BOOST_TEST(round_trip(val));
+        BOOST_TEST(round_trip(val, true));
+
+        // tags (e.g. source lines) are kept
+        std::string buffer;
+        BOOST_TEST(scheme::output::generate_binary(buffer, val));
+
+        utree tagged;
+        BOOST_TEST(scheme::input::parse_binary(buffer.data()
+          , buffer.data() + buffer.size(), tagged));
+        BOOST_TEST(tagged.tag() == 42);
+        BOOST_TEST(tagged[2].tag() == -7);
+        BOOST_TEST(tagged[2][2].tag() == 0);
+
+        // repeated symbols are stored only once
+        std::string once, twice;
+        utree sym(utf8_symbol_type("a-rather-long-symbol"));
+        utree list;
+        list.push_back(sym);
+        scheme::output::generate_binary(once, list);
+        list.push_back(sym);
+        scheme::output::generate_binary(twice, list);
+        BOOST_TEST(twice.size() < once.size() + 4);
+
+        // stream interface
+        std::stringstream strm;
+        BOOST_TEST(scheme::output::generate_binary(strm, val));
+
+        utree result;
+        BOOST_TEST(scheme::input::parse_binary(strm, result));
+        BOOST_TEST(result == val);
+    }
+
+    {
+        // shallow strings refer to the buffer
+        utree val;
+        val.push_back("a string longer than the small string buffer");
+        val.push_back(utf8_symbol_type("symbol"));
+
+        std::string buffer;
+        BOOST_TEST(scheme::output::generate_binary(buffer, val));
+
+        char const* first = buffer.data();
+        char const* last = first + buffer.size();
+
+        utree result;
+        BOOST_TEST(scheme::input::parse_binary(first, last, result, true));
+        BOOST_TEST(result == val);
+        BOOST_TEST(result[0].which() == utree_type::string_range_type);
+
+        utf8_string_range_type str = result[0].get<utf8_string_range_type>();
+        BOOST_TEST(str.begin() >= first && str.end() <= last);
+
+        BOOST_TEST(scheme::input::parse_binary(first, last, result));
+        BOOST_TEST(result[0].which() == utree_type::string_type);
+        BOOST_TEST(result == val);
+    }
+
+    {
+        // pointers and functions can't be stored
+        int i = 0;
+        utree val;
+        val.push_back(utree(boost::spirit::any_ptr(&i)));
+
+        std::string buffer;
+        BOOST_TEST(!scheme::output::generate_binary(buffer, val));
+    }
+
+    {
+        // malformed input is rejected
+        utree val;
+        val.push_back("string");
+        val.push_back(utf8_symbol_type("symbol"));
+        val.push_back(12345);
+
+        std::string buffer;
+        BOOST_TEST(scheme::output::generate_binary(buffer, val));
+
+        utree result;
+        char const* first = buffer.data();
+        for (std::size_t size = 0; size < buffer.size(); ++size)
+            BOOST_TEST(!scheme::input::parse_binary(first, first + size, result));
+
+        std::string trailing(buffer + '\0');
+        BOOST_TEST(!scheme::input::parse_binary(
+            trailing.data(), trailing.data() + trailing.size(), result));
+
+        std::string bad_magic(buffer);
+        bad_magic[0] = 'X';
+        BOOST_TEST(!scheme::input::parse_binary(
+            bad_magic.data(), bad_magic.data() + bad_magic.size(), result));
+
+        // a reference to an unknown symbol
+        std::string bad_ref(buffer.substr(0, 5));
+        bad_ref += char(scheme::binary_format::symbol_ref);
+        bad_ref += char(0);
+        BOOST_TEST(!scheme::input::parse_binary(
+            bad_ref.data(), bad_ref.data() + bad_ref.size(), result));
+    }
+
+    return boost::report_errors();
+}
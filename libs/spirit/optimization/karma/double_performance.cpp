@@ -20,6 +20,14 @@
 using boost::spirit::karma::double_;
 //]
 
+// generate the shortest representation converting back to the same number
+template <typename T>
+struct shortest_policy : boost::spirit::karma::real_policies<T>
+{
+    static bool const shortest = true;
+    static unsigned precision(T) { return 17; }
+};
+
 void format_performance_karma()
 {
     using boost::spirit::karma::generate;
@@ -40,6 +48,24 @@ void format_performance_karma()
 //     std::cout << buffer << std::endl;
 }
 
+void format_performance_shortest()
+{
+    using boost::spirit::karma::generate;
+    using boost::spirit::karma::real_generator;
+
+    real_generator<double, shortest_policy<double> > const shortest_double;
+    char buffer[256];
+    util::high_resolution_timer t;
+    for (int i = 0; i < NUMITERATIONS; ++i) {
+        char *p = buffer;
+        generate(p, shortest_double, 12345.12345);
+        *p = '\0';
+    }
+
+    std::cout << "karma (shortest):\t" << t.elapsed() << std::endl;
+//     std::cout << buffer << std::endl;
+}
+
 void format_performance_rule()
 {
     using boost::spirit::karma::generate;
@@ -161,6 +187,7 @@ int main()
     format_performance_iostreams();
     format_performance_boost_format();
     format_performance_karma();
+    format_performance_shortest();
     format_performance_string();
     format_performance_rule();
     format_performance_direct();
@@ -29,6 +29,14 @@ struct random_fill
     }
 };
 
+// generate the shortest representation converting back to the same number
+template <typename T>
+struct shortest_policy : karma::real_policies<T>
+{
+    static bool const shortest = true;
+    static unsigned precision(T) { return 17; }
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 int main()
 {
@@ -101,6 +109,24 @@ int main()
         cout << "double_: " << t.elapsed() << " [s]" << flush << endl;
     }
 
+    // test the Karma double_ generation routines using the shortest 
+    // representation
+    {
+        std::string str;
+        karma::real_generator<double, shortest_policy<double> > shortest_double;
+        util::high_resolution_timer t;
+
+        for (int i = 0; i < MAX_ITERATION; ++i)
+        {
+            char *ptr = buffer;
+            karma::generate(ptr, shortest_double, v[i]);
+            *ptr = '\0';
+            str = buffer;      // compensate for string ops in other benchmarks
+        }
+
+        cout << "shortest double_: " << t.elapsed() << " [s]" << flush << endl;
+    }
+
     return 0;
 }
 
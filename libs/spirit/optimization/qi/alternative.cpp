@@ -0,0 +1,130 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#include "../measure.hpp"
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <boost/spirit/include/qi_operator.hpp>
+#include <boost/spirit/include/qi_char.hpp>
+#include <boost/spirit/include/qi_string.hpp>
+#include <boost/spirit/include/qi_lexeme.hpp>
+#include <boost/spirit/include/qi_nonterminal.hpp>
+#include <boost/spirit/include/qi_parse.hpp>
+
+//  Define BOOST_SPIRIT_QI_NO_FIRST_CHAR_DISPATCH to measure the alternative
+//  parser trying all of its alternatives in order.
+
+namespace
+{
+    namespace qi = boost::spirit::qi;
+    namespace ascii = boost::spirit::ascii;
+
+    char const* const keywords[] =
+    {
+        "break", "case", "catch", "continue", "default", "delete", "do",
+        "else", "for", "goto", "if", "new", "return", "sizeof", "switch",
+        "throw", "try", "using", "while", "asm", "auto", "enum", "extern",
+        "friend", "inline", "long", "mutable", "short", "static", "typedef"
+    };
+    std::size_t const keyword_count = sizeof(keywords)/sizeof(keywords[0]);
+
+    std::string input;
+
+    typedef std::string::const_iterator iterator_type;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A statement level alternative of 30 keyword statements, followed by
+    // an identifier statement as the fallback
+    struct statements
+    {
+        statements()
+        {
+            using qi::lit;
+            using ascii::alpha;
+            using ascii::alnum;
+
+            statement =
+                    (lit("break") >> ';')
+                |   (lit("case") >> ';')
+                |   (lit("catch") >> ';')
+                |   (lit("continue") >> ';')
+                |   (lit("default") >> ';')
+                |   (lit("delete") >> ';')
+                |   (lit("do") >> ';')
+                |   (lit("else") >> ';')
+                |   (lit("for") >> ';')
+                |   (lit("goto") >> ';')
+                |   (lit("if") >> ';')
+                |   (lit("new") >> ';')
+                |   (lit("return") >> ';')
+                |   (lit("sizeof") >> ';')
+                |   (lit("switch") >> ';')
+                |   (lit("throw") >> ';')
+                |   (lit("try") >> ';')
+                |   (lit("using") >> ';')
+                |   (lit("while") >> ';')
+                |   (lit("asm") >> ';')
+                |   (lit("auto") >> ';')
+                |   (lit("enum") >> ';')
+                |   (lit("extern") >> ';')
+                |   (lit("friend") >> ';')
+                |   (lit("inline") >> ';')
+                |   (lit("long") >> ';')
+                |   (lit("mutable") >> ';')
+                |   (lit("short") >> ';')
+                |   (lit("static") >> ';')
+                |   (lit("typedef") >> ';')
+                |   (qi::lexeme[alpha >> *alnum] >> ';')
+                ;
+
+            program = *statement;
+        }
+
+        qi::rule<iterator_type, ascii::space_type> statement, program;
+    };
+
+    statements const grammar;
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct alternative_test : test::base
+    {
+        void benchmark()
+        {
+            std::string const& in = input;
+            iterator_type first = in.begin();
+            qi::phrase_parse(first, in.end(), grammar.program, ascii::space);
+            this->val += int(first - in.begin());
+        }
+    };
+}
+
+int main()
+{
+    // Seed the random generator
+    srand(time(0));
+
+    // Generate the input: keyword statements with an identifier statement
+    // every once in a while
+    for (int i = 0; i < 20; ++i)
+    {
+        if (rand() % 8 == 0)
+            input += "identifier";
+        else
+            input += keywords[rand() % keyword_count];
+        input += "; ";
+    }
+
+    BOOST_SPIRIT_TEST_BENCHMARK(
+        1000,       // This is the maximum repetitions to execute
+        (alternative_test)
+    )
+
+    // This is ultimately responsible for preventing all the test code
+    // from being optimized away.  Change this to return 0 and you
+    // unplug the whole test's life support system.
+    return test::live_code != 0;
+}
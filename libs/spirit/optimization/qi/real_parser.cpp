@@ -76,6 +76,28 @@ namespace
             }
         }
     };
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct spirit_exact_double_test : test::base
+    {
+        static double parse(char const* first, char const* last)
+        {
+            double n;
+            namespace qi = boost::spirit::qi;
+            qi::real_parser<double, qi::exact_real_policies<double> > exact_double;
+            qi::parse(first, last, exact_double, n);
+            return n;
+        }
+
+        void benchmark()
+        {
+            for (int i = 0; i < ndigits; ++i) 
+            {
+                double d = parse(first[i], last[i]);
+                this->val += *reinterpret_cast<int*>(&d);
+            }
+        }
+    };
 }
 
 int main()
@@ -92,13 +114,14 @@ int main()
     }
     std::cout.precision(17);
     std::cout << "///////////////////////////////////////////////////////////////////////////" << std::endl;
-    std::cout << "atof/strtod/qi.double results:" << std::endl;
+    std::cout << "atof/strtod/qi.double/exact qi.double results:" << std::endl;
     for (int i = 0; i < ndigits; ++i)
     {
         std::cout 
             << atof(first[i]) << ','
             << strtod(first[i], const_cast<char**>(&last[i])) << ','
             << spirit_double_test::parse(first[i], last[i]) << ','
+            << spirit_exact_double_test::parse(first[i], last[i]) << ','
             << std::endl;
     }
     std::cout << "///////////////////////////////////////////////////////////////////////////" << std::endl;
@@ -108,6 +131,7 @@ int main()
         (atof_test)
         (strtod_test)
         (spirit_double_test)
+        (spirit_exact_double_test)
     )
     
     // This is ultimately responsible for preventing all the test code
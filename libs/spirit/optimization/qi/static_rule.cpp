@@ -0,0 +1,147 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#include "../measure.hpp"
+#include <string>
+#include <cstdlib>
+#include <boost/spirit/include/qi_operator.hpp>
+#include <boost/spirit/include/qi_char.hpp>
+#include <boost/spirit/include/qi_nonterminal.hpp>
+#include <boost/spirit/include/qi_parse.hpp>
+#include <boost/typeof/typeof.hpp>
+
+namespace
+{
+    namespace qi = boost::spirit::qi;
+
+    std::string input;
+
+    typedef std::string::const_iterator iterator_type;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // an arithmetic expression grammar built from (small) rules
+    struct calculator
+    {
+        calculator()
+        {
+            using qi::char_;
+            using qi::digit;
+
+            expr = term >> *(char_("+-") >> term);
+            term = factor >> *(char_("*/") >> factor);
+            factor = -sign >> primary;
+            sign = char_("+-");
+            primary = number | '(' >> expr >> ')';
+            number = digits >> -fraction;
+            fraction = '.' >> digits;
+            digits = +digit;
+        }
+
+        qi::rule<iterator_type> expr, term, factor, sign, primary, number
+          , fraction, digits;
+    };
+
+    calculator const grammar;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // the same grammar built from static rules, using a qi::rule only to
+    // break the recursion
+    qi::rule<iterator_type> static_expr;
+
+    BOOST_AUTO(static_digits,
+        qi::make_static_rule<iterator_type>(+qi::digit));
+    BOOST_AUTO(static_fraction,
+        qi::make_static_rule<iterator_type>('.' >> static_digits));
+    BOOST_AUTO(static_number,
+        qi::make_static_rule<iterator_type>(static_digits >> -static_fraction));
+    BOOST_AUTO(static_primary,
+        qi::make_static_rule<iterator_type>(
+            static_number | '(' >> static_expr >> ')'));
+    BOOST_AUTO(static_sign,
+        qi::make_static_rule<iterator_type>(qi::char_("+-")));
+    BOOST_AUTO(static_factor,
+        qi::make_static_rule<iterator_type>(-static_sign >> static_primary));
+    BOOST_AUTO(static_term,
+        qi::make_static_rule<iterator_type>(
+            static_factor >> *(qi::char_("*/") >> static_factor)));
+
+    struct static_calculator
+    {
+        static_calculator()
+        {
+            static_expr = static_term >> *(qi::char_("+-") >> static_term);
+        }
+    };
+
+    static_calculator const static_grammar;
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct rule_test : test::base
+    {
+        void benchmark()
+        {
+            std::string const& in = input;
+            iterator_type first = in.begin();
+            qi::parse(first, in.end(), grammar.expr);
+            this->val += int(first - in.begin());
+        }
+    };
+
+    struct static_rule_test : test::base
+    {
+        void benchmark()
+        {
+            std::string const& in = input;
+            iterator_type first = in.begin();
+            qi::parse(first, in.end(), static_expr);
+            this->val += int(first - in.begin());
+        }
+    };
+}
+
+int main()
+{
+    // Seed the random generator
+    srand(time(0));
+
+    // Generate the input: a sum of 20 products of (signed) numbers and
+    // parenthesized sums, e.g. "3*-(1.5+2)-7/4.5+..."
+    for (int i = 0; i < 20; ++i)
+    {
+        if (i != 0)
+            input += "+-"[rand() % 2];
+        for (int j = 1 + rand() % 3; j != 0; --j)
+        {
+            if (rand() % 2)
+                input += '-';
+            if (rand() % 3 == 0)
+            {
+                input += '(';
+                input += char('1' + rand() % 9);
+                input += ".5+";
+                input += char('1' + rand() % 9);
+                input += ')';
+            }
+            else
+            {
+                input += char('1' + rand() % 9);
+            }
+            if (j != 1)
+                input += "*/"[rand() % 2];
+        }
+    }
+
+    BOOST_SPIRIT_TEST_BENCHMARK(
+        10000,      // This is the maximum repetitions to execute
+        (rule_test)
+        (static_rule_test)
+    )
+
+    // This is ultimately responsible for preventing all the test code
+    // from being optimized away.  Change this to return 0 and you
+    // unplug the whole test's life support system.
+    return test::live_code != 0;
+}
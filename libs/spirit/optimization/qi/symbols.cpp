@@ -0,0 +1,163 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#include "../measure.hpp"
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <boost/spirit/include/qi_symbols.hpp>
+#include <boost/spirit/home/qi/string/tst_map.hpp>
+#include <boost/spirit/home/qi/string/flat_tst.hpp>
+#include <boost/spirit/home/qi/string/perfect_hash.hpp>
+
+namespace
+{
+    namespace qi = boost::spirit::qi;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The keyword set (by default the C++ keywords) and an input of
+    // keywords and identifiers sharing prefixes with them
+    char const* const keywords[] =
+    {
+        "asm", "auto", "bool", "break", "case", "catch", "char", "class",
+        "const", "const_cast", "continue", "default", "delete", "do",
+        "double", "dynamic_cast", "else", "enum", "explicit", "export",
+        "extern", "false", "float", "for", "friend", "goto", "if", "inline",
+        "int", "long", "mutable", "namespace", "new", "operator", "private",
+        "protected", "public", "register", "reinterpret_cast", "return",
+        "short", "signed", "sizeof", "static", "static_cast", "struct",
+        "switch", "template", "this", "throw", "true", "try", "typedef",
+        "typeid", "typename", "union", "unsigned", "using", "virtual",
+        "void", "volatile", "wchar_t", "while"
+    };
+    std::size_t const keyword_count = sizeof(keywords)/sizeof(keywords[0]);
+
+    std::vector<std::string> keys;
+    std::vector<std::string> words;
+
+    qi::symbols<char, int> tst_sym;
+    qi::symbols<char, int, qi::tst_map<char, int> > tst_map_sym;
+    qi::symbols<char, int, qi::flat_tst<char, int> > flat_tst_sym;
+    qi::symbols<char, int, qi::perfect_hash<char, int> > perfect_hash_sym;
+
+    template <typename Symbols>
+    void fill(Symbols& sym)
+    {
+        for (std::size_t i = 0; i < keys.size(); ++i)
+            sym.add(keys[i], int(i + 1));
+    }
+
+    template <typename Symbols>
+    int lookup(Symbols const& sym)
+    {
+        int result = 0;
+        for (std::size_t i = 0; i < words.size(); ++i)
+        {
+            char const* first = words[i].c_str();
+            char const* last = first + words[i].size();
+            int const* p = sym.prefix_find(first, last);
+            if (p)
+                result += *p;
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct tst_test : test::base
+    {
+        void benchmark()
+        {
+            this->val += lookup(tst_sym);
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct tst_map_test : test::base
+    {
+        void benchmark()
+        {
+            this->val += lookup(tst_map_sym);
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct flat_tst_test : test::base
+    {
+        void benchmark()
+        {
+            this->val += lookup(flat_tst_sym);
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct perfect_hash_test : test::base
+    {
+        void benchmark()
+        {
+            this->val += lookup(perfect_hash_sym);
+        }
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    // Seed the random generator
+    srand(time(0));
+
+    // Use 5000 random keys instead of the C++ keywords if there is any
+    // argument given
+    if (argc > 1)
+    {
+        for (int i = 0; i < 5000; ++i)
+        {
+            std::string key;
+            for (int n = 3 + rand() % 8; n != 0; --n)
+                key += char('a' + rand() % 26);
+            keys.push_back(key);
+        }
+    }
+    else
+    {
+        keys.assign(keywords, keywords + keyword_count);
+    }
+
+    // Generate the input: keywords, keywords followed by more characters
+    // and identifiers which are no keywords at all
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string word(keys[rand() % keys.size()]);
+        switch (rand() % 3)
+        {
+        case 1:
+            word += char('a' + rand() % 26);
+            break;
+        case 2:
+            word[0] = char('A' + rand() % 26);
+            break;
+        }
+        words.push_back(word);
+    }
+
+    fill(tst_sym);
+    fill(tst_map_sym);
+    fill(flat_tst_sym);
+    flat_tst_sym.lookup->freeze();
+    fill(perfect_hash_sym);
+    perfect_hash_sym.lookup->freeze();
+
+    BOOST_SPIRIT_TEST_BENCHMARK(
+        1000,       // This is the maximum repetitions to execute
+        (tst_test)
+        (tst_map_test)
+        (flat_tst_test)
+        (perfect_hash_test)
+    )
+
+    // This is ultimately responsible for preventing all the test code
+    // from being optimized away.  Change this to return 0 and you
+    // unplug the whole test's life support system.
+    return test::live_code != 0;
+}
@@ -0,0 +1,76 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#include "../measure.hpp"
+#include <string>
+#include <cstdlib>
+#include <boost/spirit/include/qi_operator.hpp>
+#include <boost/spirit/include/qi_char.hpp>
+#include <boost/spirit/include/qi_nonterminal.hpp>
+#include <boost/spirit/include/qi_parse.hpp>
+
+namespace
+{
+    namespace qi = boost::spirit::qi;
+    namespace wide = boost::spirit::standard_wide;
+
+    std::wstring input;
+
+    typedef std::wstring::const_iterator iterator_type;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // identifiers (including greek letters) separated by whitespace
+    struct identifiers
+    {
+        identifiers()
+        {
+            using wide::char_;
+
+            program = *(+char_(L"a-zA-Z_0-9\x3b1-\x3c9") | +char_(L" \t\r\n"));
+        }
+
+        qi::rule<iterator_type> program;
+    };
+
+    identifiers const grammar;
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct wide_char_set_test : test::base
+    {
+        void benchmark()
+        {
+            std::wstring const& in = input;
+            iterator_type first = in.begin();
+            qi::parse(first, in.end(), grammar.program);
+            this->val += int(first - in.begin());
+        }
+    };
+}
+
+int main()
+{
+    // Seed the random generator
+    srand(time(0));
+
+    // Generate the input: identifiers of 1 to 24 characters, separated by
+    // some whitespace
+    for (int i = 0; i < 20; ++i)
+    {
+        for (int j = 1 + rand() % 24; j != 0; --j)
+            input += wchar_t('a' + rand() % 26);
+        input += std::wstring(1 + rand() % 4, L' ');
+    }
+
+    BOOST_SPIRIT_TEST_BENCHMARK(
+        1000,       // This is the maximum repetitions to execute
+        (wide_char_set_test)
+    )
+
+    // This is ultimately responsible for preventing all the test code
+    // from being optimized away.  Change this to return 0 and you
+    // unplug the whole test's life support system.
+    return test::live_code != 0;
+}
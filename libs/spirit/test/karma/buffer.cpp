@@ -49,5 +49,16 @@ main()
             buffer['[' << +double_ << ']'], v, space));
     }
 
+    {   // the buffered output is stored using the character type of the sink
+        using boost::spirit::karma::int_;
+        using boost::spirit::karma::lit;
+        using boost::spirit::karma::buffer;
+
+        BOOST_TEST(test("ab12", buffer[buffer[lit('a') << 'b'] << int_], 12));
+        BOOST_TEST(test(L"\x263a" L"12"
+          , buffer[buffer[lit(L'\x263a')] << int_], 12));
+        BOOST_TEST(test("[12]", buffer['[' << buffer[int_] << ']'], 12));
+    }
+
     return boost::report_errors();
 }
@@ -76,6 +76,15 @@ struct test_minmax
         BOOST_TEST(test_delimited(expected_maxval + " ", lit(maxval), char(' ')));
         BOOST_TEST(test_delimited(expected_minval + " ", lit(minval), char(' ')));
 
+    // the numbers of digits in between
+        for (T p = 1; p <= maxval / 10; p *= 10)
+        {
+            T const below = T(p * 10 - 1);
+            T const above = T(p * 10);
+            BOOST_TEST(test(boost::lexical_cast<std::string>(below), gen, below));
+            BOOST_TEST(test(boost::lexical_cast<std::string>(above), gen, above));
+        }
+
     // action tests
         BOOST_TEST(test(expected_maxval, gen[_1 = val(maxval)]));
         BOOST_TEST(test(expected_minval, gen[_1 = val(minval)]));
@@ -14,6 +14,8 @@
 #include <boost/spirit/include/phoenix_core.hpp>
 #include <boost/spirit/include/phoenix_operator.hpp>
 
+#include <vector>
+
 #include "test.hpp"
 
 using namespace spirit_test;
@@ -167,5 +169,27 @@ main()
         BOOST_TEST((test(L"abc", string(phx::ref(ws)))));
     }
 
+    {   // strings written to pointers and vectors at once
+        using namespace boost::spirit::ascii;
+        using boost::spirit::karma::generate;
+
+        char buffer[16];
+        char* p = buffer;
+        BOOST_TEST(generate(p, lit("abc")) && 
+            generate(p, string, std::string("de")) &&
+            std::string(buffer, p) == "abcde");
+
+        std::vector<char> v;
+        std::back_insert_iterator<std::vector<char> > out(v);
+        BOOST_TEST(generate(out, lit("abc")) && 
+            generate(out, string, std::string("de")) &&
+            std::string(v.begin(), v.end()) == "abcde");
+
+        std::wstring ws;
+        std::back_insert_iterator<std::wstring> wout(ws);
+        BOOST_TEST(generate(wout, lit("abc")) && 
+            generate(wout, string, std::string("de")) && ws == L"abcde");
+    }
+
     return boost::report_errors();
 }
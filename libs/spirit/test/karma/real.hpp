@@ -116,5 +116,73 @@ struct statefull_policy : boost::spirit::karma::real_policies<T>
     bool trailingzeros_;
 };
 
+///////////////////////////////////////////////////////////////////////////////
+//  policy for real_generator, which generates the shortest representation
+//  converting back to the same number
+template <typename T>
+struct shortest_policy : boost::spirit::karma::real_policies<T>
+{
+    static bool const shortest = true;
+
+    //  we want to generate up to 17 fractional digits 
+    static unsigned int precision(T) { return 17; }
+};
+
+template <typename T>
+struct shortest_statefull_policy : statefull_policy<T>
+{
+    static bool const shortest = true;
+
+    shortest_statefull_policy(int precision = 4, bool trailingzeros = false)
+      : statefull_policy<T>(precision, trailingzeros)
+    {}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//  policy implementing the interface without deriving from real_policies, 
+//  the shortest flag is optional
+template <typename T>
+struct forwarding_policy
+{
+    typedef boost::spirit::karma::real_policies<T> base;
+    typedef typename base::properties properties;
+    typedef typename base::fmtflags fmtflags;
+
+    template <typename Inserter, typename OutputIterator, typename Policies>
+    static bool call (OutputIterator& sink, T n, Policies const& p)
+    { return Inserter::call_n(sink, n, p); }
+
+    static bool force_sign(T n) { return base::force_sign(n); }
+    static bool trailing_zeros(T n) { return base::trailing_zeros(n); }
+    static int floatfield(T n) { return base::floatfield(n); }
+    static unsigned precision(T n) { return base::precision(n); }
+
+    template <typename OutputIterator>
+    static bool integer_part (OutputIterator& sink, T n, bool sign
+      , bool force_sign)
+    { return base::integer_part(sink, n, sign, force_sign); }
+
+    template <typename OutputIterator>
+    static bool dot (OutputIterator& sink, T n, unsigned precision)
+    { return base::dot(sink, n, precision); }
+
+    template <typename OutputIterator>
+    static bool fraction_part (OutputIterator& sink, T n
+      , unsigned adjprec, unsigned precision)
+    { return base::fraction_part(sink, n, adjprec, precision); }
+
+    template <typename CharEncoding, typename Tag, typename OutputIterator>
+    static bool exponent (OutputIterator& sink, long n)
+    { return base::template exponent<CharEncoding, Tag>(sink, n); }
+
+    template <typename CharEncoding, typename Tag, typename OutputIterator>
+    static bool nan (OutputIterator& sink, T n, bool force_sign)
+    { return base::template nan<CharEncoding, Tag>(sink, n, force_sign); }
+
+    template <typename CharEncoding, typename Tag, typename OutputIterator>
+    static bool inf (OutputIterator& sink, T n, bool force_sign)
+    { return base::template inf<CharEncoding, Tag>(sink, n, force_sign); }
+};
+
 #endif // BOOST_SPIRIT_TEST_REAL_NUMERICS_HPP
 
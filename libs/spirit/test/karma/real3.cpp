@@ -124,6 +124,48 @@ int main()
     }
 #endif
 
+    // test the shortest representation
+    {
+        typedef karma::real_generator<double, shortest_policy<double> > 
+            shortest_type;
+        shortest_type const shortest = shortest_type();
+
+        BOOST_TEST(test("0.0", shortest, 0.0));
+        BOOST_TEST(test("0.0", shortest, -0.0));
+        BOOST_TEST(test("1.0", shortest, 1.0));
+        BOOST_TEST(test("0.1", shortest, 0.1));
+        BOOST_TEST(test("0.30000000000000004", shortest, 0.1 + 0.2));
+        BOOST_TEST(test("-0.3333333333333333", shortest, -1.0 / 3));
+        BOOST_TEST(test("12345.12345", shortest, 12345.12345));
+        BOOST_TEST(test("1.0e23", shortest, 1e23));
+        BOOST_TEST(test("5.0e-324", shortest, 4.9406564584124654e-324));
+        BOOST_TEST(test("1.7976931348623157e308", shortest, 
+            1.7976931348623157e308));                   // DBL_MAX
+        BOOST_TEST(test("2.2250738585072014e-308", shortest, 
+            2.2250738585072014e-308));                  // DBL_MIN
+
+        typedef karma::real_generator<float, shortest_policy<float> > 
+            shortest_float_type;
+        shortest_float_type const shortest_float = shortest_float_type();
+
+        BOOST_TEST(test("0.1", shortest_float, 0.1f));
+        BOOST_TEST(test("0.33333334", shortest_float, 1.0f / 3));
+        BOOST_TEST(test("3.4028235e38", shortest_float, 3.4028235e38f));
+
+        // the precision still limits the number of fractional digits
+        typedef karma::real_generator<double
+          , shortest_statefull_policy<double> > statefull_type;
+
+        statefull_type const s3(shortest_statefull_policy<double>(3, false));
+        BOOST_TEST(test("0.1", s3, 0.1));
+        BOOST_TEST(test("0.333", s3, 1.0 / 3));
+
+        statefull_type const s5(shortest_statefull_policy<double>(5, true));
+        BOOST_TEST(test("0.10000", s5, 0.1));
+        BOOST_TEST(test("1.25000e05", s5, 125000.0));
+        BOOST_TEST(test("0.33333", s5, 1.0 / 3));
+    }
+
     {
         boost::optional<double> v;
         BOOST_TEST(!test("", double_, v));
@@ -134,6 +176,17 @@ int main()
         BOOST_TEST(test("1.0", double_(1.0), v));
     }
 
+    // policies without the shortest flag
+    {
+        typedef karma::real_generator<double, forwarding_policy<double> > 
+            forwarding_type;
+        forwarding_type const forwarding = forwarding_type();
+
+        BOOST_TEST(test("0.1", forwarding, 0.1));
+        BOOST_TEST(test("-1.5", forwarding, -1.5));
+        BOOST_TEST(test("1.0e23", forwarding, 1e23));
+    }
+
 // we support Phoenix attributes only starting with V2.2
 #if SPIRIT_VERSION >= 0x2020
     {   // Phoenix expression tests (requires to include 
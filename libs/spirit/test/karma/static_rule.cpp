@@ -0,0 +1,97 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/config/warning_disable.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#include <boost/spirit/include/karma_operator.hpp>
+#include <boost/spirit/include/karma_char.hpp>
+#include <boost/spirit/include/karma_auxiliary.hpp>
+#include <boost/spirit/include/karma_string.hpp>
+#include <boost/spirit/include/karma_numeric.hpp>
+#include <boost/spirit/include/karma_nonterminal.hpp>
+#include <boost/spirit/include/karma_action.hpp>
+#include <boost/spirit/include/phoenix_core.hpp>
+#include <boost/spirit/include/phoenix_operator.hpp>
+#include <boost/typeof/typeof.hpp>
+
+#include <vector>
+
+#include "test.hpp"
+
+using namespace spirit_test;
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    using namespace boost;
+    using namespace boost::spirit;
+    using namespace boost::spirit::ascii;
+    using karma::make_static_rule;
+
+    typedef spirit_test::output_iterator<char>::type outiter_type;
+
+    // plain static rules, referring to each other and used from a rule
+    {
+        BOOST_AUTO(a, make_static_rule<outiter_type>(lit('a'), "a"));
+        BOOST_AUTO(b, make_static_rule<outiter_type>(lit('b'), "b"));
+        BOOST_AUTO(ab, make_static_rule<outiter_type>(a << b));
+        karma::rule<outiter_type> start = ab << 'c' << ab;
+
+        BOOST_TEST(test("ab", ab));
+        BOOST_TEST(test("abcab", start));
+        BOOST_TEST(a.name() == "a");
+    }
+
+    // attributes
+    {
+        BOOST_AUTO(number, (make_static_rule<outiter_type, int()>(int_)));
+        BOOST_AUTO(twice,
+            (make_static_rule<outiter_type, int()>(number[_1 = _val * 2])));
+
+        BOOST_TEST(test("123", number, 123));
+        BOOST_TEST(test("42", twice, 21));
+
+        std::vector<int> v;
+        v.push_back(1);
+        v.push_back(2);
+        v.push_back(3);
+        BOOST_TEST(test("1,2,3", number % ',', v));
+    }
+
+    // delimiter and inherited attributes
+    {
+        BOOST_AUTO(numbers, (make_static_rule<
+            outiter_type, std::vector<int>(), space_type>(int_ % ',')));
+        BOOST_AUTO(exactly, (make_static_rule<outiter_type, void(int)>(
+            int_(_r1))));
+
+        std::vector<int> v;
+        v.push_back(1);
+        v.push_back(2);
+        BOOST_TEST(test_delimited("1 , 2 ", numbers, v, space));
+        BOOST_TEST(test("5", exactly(5)));
+
+        // without a delimiter, the rule is an implied verbatim as a
+        // karma::rule
+        BOOST_AUTO(ab, make_static_rule<outiter_type>(lit('a') << 'b'));
+        karma::rule<outiter_type> ab_rule = lit('a') << 'b';
+
+        BOOST_TEST(test_delimited("ab ", ab, space));
+        BOOST_TEST(test_delimited("ab ", ab_rule, space));
+        BOOST_TEST(test_delimited("ab ab ", ab << ab, space));
+    }
+
+    // static rules referring to a rule
+    {
+        karma::rule<outiter_type, int()> value = int_;
+        BOOST_AUTO(element, (make_static_rule<outiter_type, int()>(
+            '[' << value << ']')));
+
+        BOOST_TEST(test("[7]", element, 7));
+    }
+
+    return boost::report_errors();
+}
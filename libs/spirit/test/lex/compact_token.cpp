@@ -0,0 +1,84 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/config/warning_disable.hpp>
+
+#include <boost/spirit/include/lex_lexertl.hpp>
+#include <boost/spirit/include/qi_parse.hpp>
+#include <boost/spirit/include/qi_operator.hpp>
+#include <boost/spirit/include/qi_directive.hpp>
+#include <boost/spirit/include/qi_numeric.hpp>
+
+#include <string>
+#include <vector>
+
+namespace lex = boost::spirit::lex;
+namespace qi = boost::spirit::qi;
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Lexer>
+struct number_tokens : lex::lexer<Lexer>
+{
+    number_tokens()
+      : number("[0-9]+"), identifier("[a-z]+")
+    {
+        this->self = number | identifier;
+    }
+
+    lex::token_def<unsigned int> number;
+    lex::token_def<std::string> identifier;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    typedef std::string::const_iterator base_iterator_type;
+    typedef lex::lexertl::compact_token<base_iterator_type> token_type;
+    typedef lex::lexertl::lexer<token_type> lexer_type;
+    typedef number_tokens<lexer_type> tokens_type;
+    typedef tokens_type::iterator_type iterator_type;
+
+    BOOST_TEST(sizeof(token_type) <=
+        sizeof(lex::lexertl::token<base_iterator_type>));
+
+    tokens_type tokens;
+
+    // token ids, states and values
+    {
+        std::string const input("abc 42 de");
+        base_iterator_type first = input.begin();
+
+        iterator_type it = tokens.begin(first, input.end());
+        iterator_type end = tokens.end();
+
+        BOOST_TEST(it != end && (*it).id() == tokens.identifier.id());
+        BOOST_TEST((*it).state() == 0);
+        BOOST_TEST(std::string((*it).value().begin(), (*it).value().end())
+            == "abc");
+        BOOST_TEST(++it != end && !token_is_valid(*it));   // no match
+    }
+
+    // token values converted to attributes, with backtracking
+    {
+        std::string const input("abc42de7");
+        base_iterator_type first = input.begin();
+
+        std::vector<unsigned int> numbers;
+        BOOST_TEST(lex::tokenize_and_parse(first, input.end(), tokens,
+            *(qi::omit[tokens.identifier] >> tokens.number), numbers));
+        BOOST_TEST(first == input.end());
+        BOOST_TEST(numbers.size() == 2 && numbers[0] == 42 && numbers[1] == 7);
+
+        first = input.begin();
+        std::vector<std::string> names;
+        BOOST_TEST(lex::tokenize_and_parse(first, input.end(), tokens,
+            &tokens.identifier >> tokens.identifier % qi::omit[tokens.number],
+            names));
+        BOOST_TEST(names.size() == 2 && names[0] == "abc" && names[1] == "de");
+    }
+
+    return boost::report_errors();
+}
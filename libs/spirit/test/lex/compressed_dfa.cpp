@@ -0,0 +1,171 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/spirit/include/lex_lexertl.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace lex = boost::spirit::lex;
+
+///////////////////////////////////////////////////////////////////////////////
+//  a lexer using states, BOL/EOL assertions and lexer state switching
+template <typename Lexer>
+struct test_tokens : lex::lexer<Lexer>
+{
+    test_tokens(unsigned int flags)
+      : lex::lexer<Lexer>(flags)
+    {
+        this->self.add
+            ("^#[a-z]+", 1)
+            ("[a-zA-Z_][a-zA-Z0-9_]*", 2)
+            ("[0-9]+", 3)
+            ("[ \\t]+", 4)
+            ("\\n", 5)
+            ("end$", 6)
+        ;
+        this->self("INITIAL", "COMMENT").add("\\/\\*", 7);
+        this->self("COMMENT", "INITIAL").add("\\*\\/", 8);
+        this->self("COMMENT").add("[^*]+|\\*", 9);
+    }
+};
+
+struct collect
+{
+    typedef bool result_type;
+
+    collect(std::vector<std::size_t>& ids) : ids_(ids) {}
+
+    template <typename Token>
+    bool operator()(Token const& t) const
+    {
+        ids_.push_back(t.id());
+        return true;
+    }
+
+    std::vector<std::size_t>& ids_;
+};
+
+template <typename Lexer, typename Char>
+std::vector<std::size_t> tokenize(Lexer const& lexer, Char const* input)
+{
+    std::vector<std::size_t> ids;
+    Char const* first = input;
+    Char const* last = input;
+    while (*last)
+        ++last;
+
+    lex::tokenize(first, last, lexer, collect(ids));
+    if (first != last)
+        ids.push_back(std::size_t(-1));
+    return ids;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  compare the token sequences produced from both state machines
+template <typename Char>
+bool compare(boost::lexer::basic_state_machine<Char> const& sm
+  , boost::lexer::basic_state_machine<Char> const& compressed
+  , Char const* input)
+{
+    typedef lex::lexertl::basic_iterator_tokeniser<Char const*> tokeniser;
+
+    Char const* first = input;
+    Char const* last = input;
+    while (*last)
+        ++last;
+
+    Char const* cfirst = first;
+    bool bol = true, cbol = true;
+    std::size_t uid = 0, cuid = 0;
+    while (first != last)
+    {
+        std::size_t id = tokeniser::next(sm, bol, first, last, uid);
+        std::size_t cid = tokeniser::next(compressed, cbol, cfirst, last, cuid);
+
+        if (id != cid || uid != cuid || first != cfirst || bol != cbol)
+            return false;
+        if (id == boost::lexer::npos)
+            break;
+    }
+    return first == cfirst;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    {
+        typedef lex::lexertl::token<char const*> token_type;
+        typedef lex::lexertl::lexer<token_type> lexer_type;
+
+        test_tokens<lexer_type> plain(lex::match_flags::match_default);
+        test_tokens<lexer_type> compressed(
+            lex::match_flags::match_compress_dfa);
+
+        char const* inputs[] = {
+            "#define abc 123\n",
+            "abc /* a * comment */ 42\nend\nend x\n",
+            "  #nobol end",
+            "abc $ def",
+            ""
+        };
+
+        for (std::size_t i = 0; i < sizeof(inputs)/sizeof(inputs[0]); ++i)
+        {
+            BOOST_TEST(tokenize(plain, inputs[i]) ==
+                tokenize(compressed, inputs[i]));
+        }
+
+        std::vector<std::size_t> ids = tokenize(compressed, "#a b /*c*/\n");
+        BOOST_TEST(ids.size() == 8 && ids[0] == 1 && ids[2] == 2 &&
+            ids[4] == 7 && ids[5] == 9 && ids[6] == 8 && ids[7] == 5);
+    }
+
+    {
+        boost::lexer::wrules rules;
+        rules.add(L"[a-z]+", 1);
+        rules.add(L"[\\x100-\\x200]+", 2);
+        rules.add(L"\\s+", 3);
+
+        boost::lexer::wstate_machine sm;
+        boost::lexer::wgenerator::build(rules, sm);
+
+        boost::lexer::wstate_machine compressed;
+        boost::lexer::wgenerator::build(rules, compressed);
+        boost::lexer::wgenerator::compress(compressed);
+
+        BOOST_TEST(compressed.data()._compressed[0]->_width == 1);
+        BOOST_TEST(compare(sm, compressed, L"abc \x150\x151 \x300 def"));
+    }
+
+    {
+        // more than 255 states require 16 bit cells
+        boost::lexer::rules rules;
+        for (int i = 0; i < 400; ++i)
+        {
+            std::ostringstream strm;
+            strm << "keyword" << i << "x";
+            rules.add(strm.str().c_str(), i + 1);
+        }
+
+        boost::lexer::state_machine sm;
+        boost::lexer::generator::build(rules, sm);
+
+        boost::lexer::state_machine compressed;
+        boost::lexer::generator::build(rules, compressed);
+        boost::lexer::generator::compress(compressed);
+
+        BOOST_TEST(!(sm == compressed));
+        BOOST_TEST(compressed.data()._compressed->size() == 1);
+        BOOST_TEST(compressed.data()._compressed[0]->_width == 2);
+
+        BOOST_TEST(compare(sm, compressed
+          , "keyword42x keyword7x keyword399xkeyword0x"));
+    }
+
+    return boost::report_errors();
+}
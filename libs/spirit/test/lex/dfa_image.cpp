@@ -0,0 +1,183 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/spirit/include/lex_lexertl.hpp>
+#include <boost/spirit/include/lex_generate_static_lexertl.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace lex = boost::spirit::lex;
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Lexer>
+struct test_tokens : lex::lexer<Lexer>
+{
+    test_tokens(bool extra = false)
+    {
+        this->self.add
+            ("^#[a-z]+", 1)
+            ("[a-zA-Z_][a-zA-Z0-9_]*", 2)
+            ("[0-9]+", 3)
+            ("[ \\t\\n]+", 4)
+        ;
+        this->self("INITIAL", "COMMENT").add("\\/\\*", 5);
+        this->self("COMMENT", "INITIAL").add("\\*\\/", 6);
+        this->self("COMMENT").add("[^*]+|\\*", 7);
+
+        if (extra)
+            this->self.add("@", 8);
+    }
+};
+
+struct collect
+{
+    typedef bool result_type;
+
+    collect(std::vector<std::size_t>& ids) : ids_(ids) {}
+
+    template <typename Token>
+    bool operator()(Token const& t) const
+    {
+        ids_.push_back(t.id());
+        return true;
+    }
+
+    std::vector<std::size_t>& ids_;
+};
+
+template <typename Lexer>
+std::vector<std::size_t> tokenize(Lexer const& lexer, std::string const& input)
+{
+    std::vector<std::size_t> ids;
+    char const* first = input.c_str();
+    char const* last = first + input.size();
+
+    lex::tokenize(first, last, lexer, collect(ids));
+    if (first != last)
+        ids.push_back(std::size_t(-1));
+    return ids;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    typedef lex::lexertl::token<char const*> token_type;
+    typedef lex::lexertl::lexer<token_type> lexer_type;
+
+    std::string input("#define abc 42 /* a comment */\n#x y");
+
+    // write the image
+    test_tokens<lexer_type> original;
+    std::vector<std::size_t> expected = tokenize(original, input);
+
+    std::ostringstream strm;
+    BOOST_TEST(original.save_dfa_image(strm));
+    BOOST_TEST(tokenize(original, input) == expected);
+
+    // copy the image into memory aligned to 8 bytes
+    std::string image(strm.str());
+    std::vector<boost::uint64_t> buffer(image.size() / 8 + 1);
+    std::memcpy(&buffer.front(), image.data(), image.size());
+
+    {
+        test_tokens<lexer_type> adopted;
+        BOOST_TEST(adopted.adopt_dfa_image(&buffer.front(), image.size()));
+        BOOST_TEST(tokenize(adopted, input) == expected);
+    }
+
+    {
+        // different token definitions
+        test_tokens<lexer_type> other(true);
+        BOOST_TEST(!other.adopt_dfa_image(&buffer.front(), image.size()));
+        BOOST_TEST(tokenize(other, input) == expected);
+    }
+
+    {
+        // truncated image
+        test_tokens<lexer_type> truncated;
+        BOOST_TEST(!truncated.adopt_dfa_image(&buffer.front(), image.size() - 8));
+        BOOST_TEST(!truncated.adopt_dfa_image(&buffer.front(), 16));
+        BOOST_TEST(tokenize(truncated, input) == expected);
+    }
+
+    {
+        // corrupt image
+        typedef boost::lexer::detail::image_header image_header;
+        typedef boost::lexer::detail::image_dfa image_dfa;
+
+        std::vector<boost::uint64_t> corrupt(buffer);
+        image_header const* header = 
+            reinterpret_cast<image_header const*>(&corrupt.front());
+        image_dfa* dfa = reinterpret_cast<image_dfa*>(
+            reinterpret_cast<char*>(&corrupt.front()) + sizeof(image_header));
+
+        test_tokens<lexer_type> lexer;
+        dfa->_states_offset += 1;
+        BOOST_TEST(!lexer.adopt_dfa_image(&corrupt.front(), image.size()));
+
+        corrupt = buffer;
+        dfa->_cells = std::size_t(-8);
+        BOOST_TEST(!lexer.adopt_dfa_image(&corrupt.front(), image.size()));
+
+        // a transition to a state which does not exist
+        corrupt = buffer;
+        std::memset(reinterpret_cast<char*>(&corrupt.front()) + dfa->_cells
+            + dfa->_rows_offset * header->_width, 0xff, header->_width);
+        BOOST_TEST(!lexer.adopt_dfa_image(&corrupt.front(), image.size()));
+
+        // a character mapped to a column which does not exist
+        corrupt = buffer;
+        std::memset(reinterpret_cast<char*>(&corrupt.front()) + dfa->_cells
+            + 'a' * header->_width, 0xff, header->_width);
+        BOOST_TEST(!lexer.adopt_dfa_image(&corrupt.front(), image.size()));
+
+        BOOST_TEST(tokenize(lexer, input) == expected);
+    }
+
+    {
+        // static lexers can't be generated from the compressed tables only
+        test_tokens<lexer_type> adopted;
+        BOOST_TEST(adopted.adopt_dfa_image(&buffer.front(), image.size()));
+
+        std::ostringstream out;
+        BOOST_TEST(!lex::lexertl::generate_static_dfa(adopted, out));
+        BOOST_TEST(out.str().empty());
+    }
+
+    {
+        // the image is used in place
+        boost::lexer::rules rules;
+        rules.add("[a-z]+", 1);
+        rules.add("[ ]+", 2);
+
+        boost::lexer::state_machine sm;
+        boost::lexer::generator::build(rules, sm);
+        boost::lexer::generator::compress(sm);
+
+        std::ostringstream strm;
+        boost::lexer::write_image(sm, strm);
+
+        std::string image(strm.str());
+        std::vector<boost::uint64_t> buffer(image.size() / 8 + 1);
+        std::memcpy(&buffer.front(), image.data(), image.size());
+
+        boost::lexer::state_machine adopted;
+        boost::lexer::adopt_image(adopted, &buffer.front(), image.size());
+
+        BOOST_TEST(adopted.data()._compressed->size() == 1);
+        BOOST_TEST(*adopted.data()._compressed[0] == *sm.data()._compressed[0]);
+        BOOST_TEST(adopted.data()._compressed[0]->_cells >
+            static_cast<void const*>(&buffer.front()));
+        BOOST_TEST(adopted.data()._compressed[0]->_cells <
+            static_cast<void const*>(&buffer.back()));
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,94 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//  This test is built twice, the second time with 
+//  BOOST_SPIRIT_LEXERTL_NO_COMPUTED_GOTO defined to compile the switch based
+//  fallback of the generated code.
+
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/spirit/include/lex_lexertl.hpp>
+#include <boost/spirit/include/lex_static_lexertl.hpp>
+
+#include <string>
+#include <vector>
+
+#include "goto_states_static.h"
+#include "goto_states.h"
+
+namespace lex = boost::spirit::lex;
+
+struct collect
+{
+    typedef bool result_type;
+
+    collect(std::vector<std::size_t>& ids) : ids_(ids) {}
+
+    template <typename Token>
+    bool operator()(Token const& t) const
+    {
+        ids_.push_back(t.id());
+        return true;
+    }
+
+    std::vector<std::size_t>& ids_;
+};
+
+template <typename Lexer>
+std::vector<std::size_t> tokenize(Lexer const& lexer, std::string const& input)
+{
+    std::vector<std::size_t> ids;
+    char const* first = input.c_str();
+    char const* last = first + input.size();
+
+    lex::tokenize(first, last, lexer, collect(ids));
+    if (first != last)
+        ids.push_back(std::size_t(-1));
+    return ids;
+}
+
+int main()
+{
+    typedef lex::lexertl::token<char const*> token_type;
+    typedef lex::lexertl::lexer<token_type> lexer_type;
+    typedef lex::lexertl::static_lexer<
+        token_type, lex::lexertl::static_::lexer_goto_states
+    > static_lexer_type;
+
+    goto_states_tokens<lexer_type> dynamic_lexer;
+    goto_states_tokens<static_lexer_type> static_lexer;
+
+    {
+        // '^' at the start of the input and after a newline, '$' before a
+        // newline and at the end of the input
+        std::string input("#define abc 42\nx\n#z q");
+        std::size_t const ids[] = { 1, 5, 3, 5, 4, 5, 2, 5, 1, 5, 2 };
+        std::vector<std::size_t> expected(ids, ids + sizeof(ids)/sizeof(ids[0]));
+
+        BOOST_TEST(tokenize(dynamic_lexer, input) == expected);
+        BOOST_TEST(tokenize(static_lexer, input) == expected);
+    }
+
+    {
+        // '^' does not match in the middle of a line
+        std::string input("x #y");
+        std::size_t const ids[] = { 3, 5, std::size_t(-1) };
+        std::vector<std::size_t> expected(ids, ids + sizeof(ids)/sizeof(ids[0]));
+
+        BOOST_TEST(tokenize(dynamic_lexer, input) == expected);
+        BOOST_TEST(tokenize(static_lexer, input) == expected);
+    }
+
+    {
+        // switching lexer states
+        std::string input("#a /* b\n#c */d\n#e");
+        std::size_t const ids[] = { 1, 5, 6, 8, 7, 2, 5, 1 };
+        std::vector<std::size_t> expected(ids, ids + sizeof(ids)/sizeof(ids[0]));
+
+        BOOST_TEST(tokenize(dynamic_lexer, input) == expected);
+        BOOST_TEST(tokenize(static_lexer, input) == expected);
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,32 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_SPIRIT_TEST_LEX_GOTO_STATES_H
+#define BOOST_SPIRIT_TEST_LEX_GOTO_STATES_H
+
+#include <boost/spirit/include/lex_lexertl.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+//  A lexer using several lexer states and rules anchored with '^' and '$', 
+//  used to test the code generated by generate_static_goto.
+template <typename Lexer>
+struct goto_states_tokens : boost::spirit::lex::lexer<Lexer>
+{
+    goto_states_tokens()
+    {
+        this->self.add
+            ("^#[a-z]+", 1)
+            ("[a-z]+$", 2)
+            ("[a-z]+", 3)
+            ("[0-9]+", 4)
+            ("[ \\t\\n]+", 5)
+        ;
+        this->self("INITIAL", "COMMENT").add("\\/\\*", 6);
+        this->self("COMMENT", "INITIAL").add("\\*\\/", 7);
+        this->self("COMMENT").add("[^*]+|\\*", 8);
+    }
+};
+
+#endif
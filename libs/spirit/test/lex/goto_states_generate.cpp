@@ -0,0 +1,26 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/spirit/include/lex_lexertl.hpp>
+#include <boost/spirit/include/lex_generate_static_lexertl.hpp>
+
+#include <fstream>
+
+#include "goto_states.h"
+
+int main(int argc, char* argv[])
+{
+    typedef boost::spirit::lex::lexertl::lexer<
+        boost::spirit::lex::lexertl::token<char const*>
+    > lexer_type;
+
+    goto_states_tokens<lexer_type> lexer;
+
+    std::ofstream out(argc < 2 ? "goto_states_static.h" : argv[1]);
+    BOOST_TEST(boost::spirit::lex::lexertl::generate_static_goto(
+        lexer, out, "goto_states"));
+    return boost::report_errors();
+}
@@ -0,0 +1,158 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_SPIRIT_THREADSAFE
+
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/spirit/include/lex_lexertl.hpp>
+
+#include <string>
+#include <vector>
+
+namespace lex = boost::spirit::lex;
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Lexer>
+struct test_tokens : lex::lexer<Lexer>
+{
+    test_tokens(unsigned int flags)
+      : test_tokens::base_type(flags)
+    {
+        this->self.add
+            ("^#[a-z]+", 1)
+            ("[a-zA-Z_][a-zA-Z0-9_]*", 2)
+            ("[0-9]+(\\.[0-9]*)?([eE][-+]?[0-9]+)?", 3)
+            ("[ \\t\\n]+", 4)
+            ("if|else|while|for|return|break|continue", 5)
+        ;
+        this->self("INITIAL", "COMMENT").add("\\/\\*", 6);
+        this->self("COMMENT", "INITIAL").add("\\*\\/", 7);
+        this->self("COMMENT").add("[^*]+|\\*", 8);
+        this->self("INITIAL", "STRING").add("\\\"", 9);
+        this->self("STRING", "INITIAL").add("\\\"", 9);
+        this->self("STRING").add("([^\"\\\\]|\\\\.)+$?", 10);
+    }
+};
+
+struct collect
+{
+    typedef bool result_type;
+
+    collect(std::vector<std::size_t>& ids) : ids_(ids) {}
+
+    template <typename Token>
+    bool operator()(Token const& t) const
+    {
+        ids_.push_back(t.id());
+        return true;
+    }
+
+    std::vector<std::size_t>& ids_;
+};
+
+template <typename Lexer>
+std::vector<std::size_t> tokenize(Lexer const& lexer, std::string const& input)
+{
+    std::vector<std::size_t> ids;
+    char const* first = input.c_str();
+    char const* last = first + input.size();
+
+    lex::tokenize(first, last, lexer, collect(ids));
+    if (first != last)
+        ids.push_back(std::size_t(-1));
+    return ids;
+}
+
+void add_keywords(boost::lexer::rules& rules, char const* state)
+{
+    std::string keyword("k");
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        keyword += char('a' + i % 26);
+        rules.add(state, keyword, 100 + i, state);
+    }
+    rules.add(state, "[a-z]+", 2, state);
+    rules.add(state, "[ \\n]+", 3, state);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    {
+        // the DFA built concurrently is identical to the one built
+        // sequentially
+        boost::lexer::rules rules;
+
+        rules.add_state("A");
+        rules.add_state("B");
+        add_keywords(rules, "INITIAL");
+        add_keywords(rules, "A");
+        add_keywords(rules, "B");
+        rules.add("B", "^x+$", 4, "B");
+
+        boost::lexer::state_machine sequential;
+        boost::lexer::generator::build(rules, sequential);
+
+        std::size_t const threads[] = { 0, 2, 3, 8 };
+        for (std::size_t i = 0; i < sizeof(threads)/sizeof(threads[0]); ++i)
+        {
+            boost::lexer::state_machine parallel;
+            boost::lexer::generator::build(rules, parallel, threads[i]);
+            BOOST_TEST(parallel == sequential);
+            BOOST_TEST(parallel.data()._seen_BOL_assertion);
+            BOOST_TEST(parallel.data()._seen_EOL_assertion);
+        }
+
+        boost::lexer::state_machine minimised;
+        boost::lexer::generator::build(rules, minimised);
+        boost::lexer::generator::minimise(minimised);
+
+        boost::lexer::state_machine parallel;
+        boost::lexer::generator::build(rules, parallel, 4);
+        boost::lexer::generator::minimise(parallel, 4);
+        BOOST_TEST(parallel == minimised);
+    }
+
+    {
+        // errors are reported from any of the threads
+        boost::lexer::rules rules;
+
+        rules.add_state("A");
+        rules.add("INITIAL", "[a-z]+", 1, "INITIAL");
+        rules.add("A", "[z-a]", 2, "A");
+
+        boost::lexer::state_machine sm;
+        bool caught = false;
+        try {
+            boost::lexer::generator::build(rules, sm, 2);
+        }
+        catch (boost::lexer::runtime_error const&) {
+            caught = true;
+        }
+        BOOST_TEST(caught);
+    }
+
+    {
+        typedef lex::lexertl::token<char const*> token_type;
+        typedef lex::lexertl::lexer<token_type> lexer_type;
+
+        std::string input("#define abc 42 /* a comment */\n"
+            "if x \"a string \\\" with escapes\" 1.5e3 while");
+
+        test_tokens<lexer_type> sequential(lex::match_flags::match_default);
+        test_tokens<lexer_type> parallel(lex::match_flags::match_parallel_dfa);
+
+        std::vector<std::size_t> expected = tokenize(sequential, input);
+        BOOST_TEST(expected.size() > 10);
+        BOOST_TEST(expected.back() != std::size_t(-1));
+        BOOST_TEST(tokenize(parallel, input) == expected);
+
+        test_tokens<lexer_type> minimised(lex::match_flags::match_default);
+        BOOST_TEST(minimised.init_dfa(true, 3));
+        BOOST_TEST(tokenize(minimised, input) == expected);
+    }
+
+    return boost::report_errors();
+}
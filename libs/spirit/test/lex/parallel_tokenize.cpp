@@ -0,0 +1,141 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_SPIRIT_THREADSAFE
+
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/spirit/include/lex_lexertl.hpp>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace lex = boost::spirit::lex;
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Lexer>
+struct test_tokens : lex::lexer<Lexer>
+{
+    test_tokens()
+    {
+        this->self.add
+            ("^#[a-z]+", 1)
+            ("[a-zA-Z_][a-zA-Z0-9_]*", 2)
+            ("[0-9]+", 3)
+            ("[ \\t\\n]+", 4)
+        ;
+        this->self("INITIAL", "COMMENT").add("\\/\\*", 6);
+        this->self("COMMENT", "INITIAL").add("\\*\\/", 7);
+        this->self("COMMENT").add("[^*]+|\\*", 8);
+        this->self("INITIAL", "STRING").add("\\\"", 9);
+        this->self("STRING", "INITIAL").add("\\\"", 9);
+        this->self("STRING").add("([^\"\\\\]|\\\\.)+", 10);
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//  generate lines containing comments and strings spanning several lines,
+//  and things only valid inside those (i.e. not at the start of a chunk).
+//  Matching a chunk starting inside a string in the wrong lexer state does
+//  not necessarily fail, as the quotes switch between both states.
+std::string generate_input(std::size_t lines)
+{
+    char const* const pieces[] = {
+        "abc ", "42 ", "#define ", "x1 ", "/* a + b\n", "- c */ ",
+        "\"s+\n", "t\\\"\" ", "/* ** */", "\t", "\n", "\n#if ", "\"s\n",
+        "q\" "
+    };
+    std::size_t const count = sizeof(pieces)/sizeof(pieces[0]);
+
+    std::string input;
+    for (std::size_t i = 0; i < lines; ++i)
+    {
+        for (int j = std::rand() % 8; j != 0; --j)
+            input += pieces[std::rand() % count];
+        input += '\n';
+    }
+    return input;
+}
+
+template <typename Token>
+bool equal(std::vector<Token> const& lhs, std::vector<Token> const& rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+    {
+        if (lhs[i].id() != rhs[i].id() || lhs[i].state() != rhs[i].state() ||
+            lhs[i].value().begin() != rhs[i].value().begin() ||
+            lhs[i].value().end() != rhs[i].value().end())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Lexer>
+void test_parallel(Lexer const& lexer, std::string const& input
+  , char const* initial_state = 0)
+{
+    typedef typename Lexer::token_type token_type;
+
+    char const* const last = input.c_str() + input.size();
+
+    std::vector<token_type> expected;
+    char const* first = input.c_str();
+    bool const expected_result =
+        lex::tokenize_all(first, last, lexer, expected, initial_state);
+    char const* const expected_first = first;
+
+    std::size_t const threads[] = { 0, 2, 3, 4, 7, 16 };
+    for (std::size_t i = 0; i < sizeof(threads)/sizeof(threads[0]); ++i)
+    {
+        std::vector<token_type> tokens;
+        first = input.c_str();
+        BOOST_TEST(expected_result == lex::tokenize_all(first, last, lexer
+          , tokens, initial_state, threads[i]));
+        BOOST_TEST(first == expected_first);
+        BOOST_TEST(equal(tokens, expected));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::srand(1);
+
+    typedef lex::lexertl::token<char const*> token_type;
+    typedef lex::lexertl::lexer<token_type> lexer_type;
+
+    test_tokens<lexer_type> lexer;
+
+    for (std::size_t i = 0; i < 20; ++i)
+    {
+        std::string input(generate_input(10 + 50 * i));
+        test_parallel(lexer, input);
+        test_parallel(lexer, input, "COMMENT");
+
+        // no match somewhere in the middle of the input
+        input.insert(input.size() / 2 + i, "\n%\n");
+        test_parallel(lexer, input);
+    }
+
+    // compact tokens
+    {
+        typedef lex::lexertl::compact_token<char const*> compact_token_type;
+        typedef lex::lexertl::lexer<compact_token_type> compact_lexer_type;
+
+        test_tokens<compact_lexer_type> compact_lexer;
+        test_parallel(compact_lexer, generate_input(1000));
+    }
+
+    // the input is not split if there are no newlines
+    test_parallel(lexer, std::string(1000, 'x'));
+    test_parallel(lexer, std::string());
+
+    return boost::report_errors();
+}
@@ -0,0 +1,119 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/spirit/include/lex_lexertl.hpp>
+
+#include <string>
+#include <vector>
+
+namespace lexertl = boost::spirit::lex::lexertl;
+
+///////////////////////////////////////////////////////////////////////////////
+struct token
+{
+    std::size_t id, uid, offset;
+    bool bol;
+
+    bool operator==(token const& rhs) const
+    {
+        return id == rhs.id && uid == rhs.uid && offset == rhs.offset &&
+            bol == rhs.bol;
+    }
+};
+
+//  tokenize the whole input using the given iterator type, the pointer
+//  based iterators use the self loop fast path
+template <typename Iterator>
+std::vector<token> tokenize(boost::lexer::state_machine const& sm
+  , Iterator first, Iterator last)
+{
+    typedef lexertl::basic_iterator_tokeniser<Iterator> tokeniser;
+
+    std::vector<token> result;
+    Iterator begin = first;
+    std::size_t state = 0;
+    bool bol = true;
+
+    while (first != last)
+    {
+        token t;
+        t.id = tokeniser::next(sm, state, bol, first, last, t.uid);
+        t.offset = std::distance(begin, first);
+        t.bol = bol;
+        result.push_back(t);
+
+        if (t.id == boost::lexer::npos)
+            break;
+    }
+    return result;
+}
+
+void build(boost::lexer::state_machine& sm, bool compress)
+{
+    boost::lexer::rules rules;
+
+    rules.add_state("STRING");
+    rules.add("INITIAL", "[ \\t\\n]+", 1, ".");
+    rules.add("INITIAL", "\\/\\*[^*]*\\*+([^/*][^*]*\\*+)*\\/", 2, ".");
+    rules.add("INITIAL", "[a-z]+", 3, ".");
+    rules.add("INITIAL", "[A-Z0-9_a-z]+", 4, ".");
+    rules.add("INITIAL", "^#[^\\n]*", 5, ".");
+    rules.add("INITIAL", "x+$", 6, ".");
+    rules.add("INITIAL", "\\\"", 7, "STRING");
+    rules.add("STRING", "[^\"\\n]+", 8, ".");
+    rules.add("STRING", "\\\"", 7, "INITIAL");
+
+    boost::lexer::generator::build(rules, sm);
+    if (compress)
+        boost::lexer::generator::compress(sm);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::string input(
+        "#include something  \n"
+        "    \t\t      \n\n\n       abcdefghijklmnopqrstuvwxyz\n"
+        "/* a longer comment spanning more than a couple of SIMD blocks, \n"
+        "   with * stars ** inside ***/ abc_DEF_0123456789_abcdefghijklmno"
+        " \"a string literal which is long enough to use the fast path\"\n"
+        "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx\n"
+        "                                                                 "
+        "  #nobol $");
+
+    for (int compress = 0; compress != 2; ++compress)
+    {
+        boost::lexer::state_machine sm;
+        build(sm, compress != 0);
+
+        // the self loops have been detected
+        BOOST_TEST(sm.data()._self_loops->size() == 2);
+
+        std::vector<token> expected = tokenize(sm
+          , std::string::const_iterator(input.begin())
+          , std::string::const_iterator(input.end()));
+
+        BOOST_TEST(expected.size() > 10);
+        BOOST_TEST(expected.back().id == boost::lexer::npos);
+        BOOST_TEST(tokenize(sm, input.c_str()
+          , input.c_str() + input.size()) == expected);
+
+        std::vector<char> buffer(input.begin(), input.end());
+        BOOST_TEST(tokenize(sm, &buffer.front()
+          , &buffer.front() + buffer.size()) == expected);
+
+        // every possible starting offset covers unaligned scans
+        for (std::size_t i = 0; i < input.size(); ++i)
+        {
+            BOOST_TEST(tokenize(sm
+              , std::string::const_iterator(input.begin() + i)
+              , std::string::const_iterator(input.end())) ==
+                tokenize(sm, input.c_str() + i, input.c_str() + input.size()));
+        }
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,135 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/config/warning_disable.hpp>
+
+#include <boost/spirit/include/lex_lexertl.hpp>
+#include <boost/spirit/include/qi_parse.hpp>
+#include <boost/spirit/include/qi_operator.hpp>
+#include <boost/spirit/include/qi_char.hpp>
+#include <boost/spirit/include/qi_directive.hpp>
+#include <boost/spirit/include/qi_numeric.hpp>
+#include <boost/spirit/include/qi_nonterminal.hpp>
+#include <boost/mpl/vector.hpp>
+
+#include <string>
+#include <vector>
+
+namespace lex = boost::spirit::lex;
+namespace qi = boost::spirit::qi;
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Lexer>
+struct number_tokens : lex::lexer<Lexer>
+{
+    number_tokens()
+      : number("[0-9]+"), identifier("[a-z]+")
+    {
+        this->self = number | identifier | ',';
+        this->self("WS") = lex::token_def<>("[ \\t]+");
+    }
+
+    lex::token_def<unsigned int> number;
+    lex::token_def<std::string> identifier;
+};
+
+template <typename Lexer>
+struct skipping_tokens : number_tokens<Lexer>
+{
+    skipping_tokens()
+    {
+        this->self += lex::token_def<>("[ \\t]+")
+            [lex::_pass = lex::pass_flags::pass_ignore];
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    typedef std::string::const_iterator base_iterator_type;
+
+    // default token type, parsing from the token vector
+    {
+        typedef lex::lexertl::token<base_iterator_type
+          , boost::mpl::vector<unsigned int, std::string> > token_type;
+        typedef lex::lexertl::lexer<token_type> lexer_type;
+        typedef std::vector<token_type>::const_iterator iterator_type;
+
+        number_tokens<lexer_type> tokens;
+
+        std::string const input("42,7de");
+        base_iterator_type first = input.begin();
+
+        std::vector<token_type> v;
+        BOOST_TEST(lex::tokenize_all(first, input.end(), tokens, v));
+        BOOST_TEST(first == input.end());
+        BOOST_TEST(v.size() == 4);
+        BOOST_TEST(v[0].id() == tokens.number.id());
+        BOOST_TEST(v[3].id() == tokens.identifier.id());
+
+        // backtracking over the stored tokens
+        qi::rule<iterator_type> start =
+                tokens.number >> ',' >> tokens.number >> ',' >> tokens.number
+            |   tokens.number >> ',' >> tokens.number >> tokens.identifier
+            ;
+
+        iterator_type it = v.begin();
+        BOOST_TEST(qi::parse(it, iterator_type(v.end()), start));
+        BOOST_TEST(it == v.end());
+
+        // token values stored in the tokens
+        qi::rule<iterator_type, std::vector<unsigned int>()> numbers =
+            tokens.number >> ',' >> tokens.number >> qi::omit[tokens.identifier];
+
+        std::vector<unsigned int> result;
+        it = v.begin();
+        BOOST_TEST(qi::parse(it, iterator_type(v.end()), numbers, result));
+        BOOST_TEST(result.size() == 2 && result[0] == 42 && result[1] == 7);
+    }
+
+    // compact tokens, initial state and unmatched input
+    {
+        typedef lex::lexertl::compact_token<base_iterator_type> token_type;
+        typedef lex::lexertl::lexer<token_type> lexer_type;
+
+        number_tokens<lexer_type> tokens;
+
+        std::string const input("abc,4!2");
+        base_iterator_type first = input.begin();
+
+        std::vector<token_type> v;
+        BOOST_TEST(!lex::tokenize_all(first, input.end(), tokens, v));
+        BOOST_TEST(first == input.begin() + 5);
+        BOOST_TEST(v.size() == 3);
+        BOOST_TEST(std::string(v[0].value().begin(), v[0].value().end())
+            == "abc");
+
+        std::string const ws(" \t ");
+        first = ws.begin();
+        v.clear();
+        BOOST_TEST(lex::tokenize_all(first, ws.end(), tokens, v, "WS"));
+        BOOST_TEST(v.size() == 1 && v[0].state() == tokens.map_state("WS"));
+    }
+
+    // semantic actions are executed while tokenizing
+    {
+        typedef lex::lexertl::token<base_iterator_type> token_type;
+        typedef lex::lexertl::actor_lexer<token_type> lexer_type;
+
+        skipping_tokens<lexer_type> tokens;
+
+        std::string const input("abc 42 ,\tde");
+        base_iterator_type first = input.begin();
+
+        std::vector<token_type> v;
+        BOOST_TEST(lex::tokenize_all(first, input.end(), tokens, v));
+        BOOST_TEST(first == input.end());
+        BOOST_TEST(v.size() == 4);
+        BOOST_TEST(v[3].id() == tokens.identifier.id());
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,173 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/config/warning_disable.hpp>
+
+#include <boost/spirit/include/lex_lexertl.hpp>
+#include <boost/spirit/include/lex_static_lexertl.hpp>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "matlib_static.h"
+
+namespace lex = boost::spirit::lex;
+
+///////////////////////////////////////////////////////////////////////////////
+//  word counting, all actions in one function object
+enum token_ids
+{
+    ID_WORD = 1000,
+    ID_EOL,
+    ID_CHAR,
+    ID_SPACE
+};
+
+struct count_actions
+{
+    count_actions() : c(0), w(0), l(0) {}
+
+    template <typename Iterator, typename Context>
+    void operator()(Iterator& start, Iterator& end
+      , BOOST_SCOPED_ENUM(lex::pass_flags)& pass, std::size_t& id
+      , Context&)
+    {
+        switch (id) {
+        case ID_WORD: ++w; c += end - start; break;
+        case ID_EOL:  ++l; ++c; break;
+        case ID_CHAR: ++c; break;
+        case ID_SPACE:
+            c += end - start;
+            pass = lex::pass_flags::pass_ignore;
+            break;
+        }
+    }
+
+    std::size_t c, w, l;
+};
+
+template <typename Lexer>
+struct word_count_tokens : lex::lexer<Lexer>
+{
+    word_count_tokens()
+    {
+        this->self.add
+            ("[^ \\t\\n]+", ID_WORD)
+            ("\\n", ID_EOL)
+            ("[ \\t]+", ID_SPACE)
+            (".", ID_CHAR)
+        ;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//  the matrix lexer from matlib.h, where the semantic actions are dispatched
+//  on the token id and the lexer state
+struct matlib_actions
+{
+    std::vector<std::vector<double> > matrix;
+    std::vector<double> row;
+
+    template <typename Iterator, typename Context>
+    void operator()(Iterator& start, Iterator& end
+      , BOOST_SCOPED_ENUM(lex::pass_flags)&, std::size_t& id
+      , Context& ctx)
+    {
+        std::string const state(ctx.get_state_name());
+        switch (id) {
+        case '[':
+            ctx.set_state_name(state == "INITIAL" ? "A" : "B");
+            break;
+        case ']':
+            if (state == "A") {
+                ctx.set_state_name("INITIAL");
+            }
+            else {
+                matrix.push_back(std::vector<double>());
+                matrix.back().swap(row);
+                ctx.set_state_name("A");
+            }
+            break;
+        case ',':
+            break;
+        default:
+            row.push_back(std::atof(std::string(start, end).c_str()));
+            break;
+        }
+    }
+};
+
+template <typename Lexer>
+struct matlib_tokens : lex::lexer<Lexer>
+{
+    matlib_tokens()
+    {
+        this->self.add_pattern("REAL1", "[0-9]+(\\.[0-9]*)?");
+        this->self.add_pattern("REAL2", "\\.[0-9]+");
+
+        number = "[-+]?({REAL1}|{REAL2})([eE][-+]?[0-9]+)?";
+
+        this->self = lex::token_def<>('[');
+        this->self("A") = lex::token_def<>('[') | ',' | lex::token_def<>(']');
+        this->self("B") = number | ',' | lex::token_def<>(']');
+    }
+
+    lex::token_def<> number;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    typedef std::string::iterator base_iterator_type;
+    typedef lex::lexertl::token<base_iterator_type
+      , lex::omit, boost::mpl::false_> token_type;
+
+    // dynamic lexer
+    {
+        typedef lex::lexertl::typed_actor_lexer<count_actions, token_type>
+            lexer_type;
+
+        word_count_tokens<lexer_type> tokens;
+
+        std::string input("hello world\nfoo\tbar  baz\n");
+        base_iterator_type first = input.begin();
+
+        BOOST_TEST(lex::tokenize(first, input.end(), tokens));
+        BOOST_TEST(tokens.actions().c == input.size());
+        BOOST_TEST(tokens.actions().w == 5);
+        BOOST_TEST(tokens.actions().l == 2);
+
+        // ignored tokens are not stored
+        std::vector<token_type> v;
+        first = input.begin();
+        BOOST_TEST(lex::tokenize_all(first, input.end(), tokens, v));
+        BOOST_TEST(v.size() == 7);
+        BOOST_TEST(tokens.actions().w == 10);
+    }
+
+    // statically generated lexer, using lexer states
+    {
+        typedef lex::lexertl::token<base_iterator_type> token_type;
+        typedef lex::lexertl::static_typed_actor_lexer<matlib_actions
+          , token_type, lex::lexertl::static_::lexer_matlib> lexer_type;
+
+        matlib_tokens<lexer_type> tokens;
+
+        std::string input("[[1,2][3][4,5,6]]");
+        base_iterator_type first = input.begin();
+
+        BOOST_TEST(lex::tokenize(first, input.end(), tokens));
+
+        std::vector<std::vector<double> > const& x = tokens.actions().matrix;
+        BOOST_TEST(x.size() == 3);
+        BOOST_TEST(x[0].size() == 2 && x[0][0] == 1 && x[0][1] == 2);
+        BOOST_TEST(x[1].size() == 1 && x[1][0] == 3);
+        BOOST_TEST(x[2].size() == 3 && x[2][2] == 6);
+    }
+
+    return boost::report_errors();
+}
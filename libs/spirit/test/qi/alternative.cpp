@@ -60,6 +60,17 @@ struct test_action_2
     }
 };
 
+#if !defined(BOOST_SPIRIT_QI_NO_FIRST_CHAR_DISPATCH)
+// returns whether a copy of the alternative p shares its jump table
+template <typename Alternative>
+bool shares_first_char_table(Alternative const& p)
+{
+    Alternative copy(p);
+    return copy.first_chars.table &&
+        copy.first_chars.table == p.first_chars.table;
+}
+#endif
+
 int
 main()
 {
@@ -216,6 +227,57 @@ main()
         BOOST_TEST(s == "abc");
     }
 
+    {   // alternatives which can't start with the next character are not
+        // tried, this must not change what is matched
+        using boost::spirit::qi::no_case;
+        using boost::spirit::qi::no_skip;
+        using boost::spirit::qi::eps;
+        using boost::spirit::ascii::alpha;
+        using boost::spirit::ascii::digit;
+        using boost::spirit::ascii::space;
+        using boost::spirit::ascii::string;
+
+        BOOST_TEST((test("else", lit("if") | lit("else") | lit("while"))));
+        BOOST_TEST((!test("for", lit("if") | lit("else") | lit("while"))));
+        BOOST_TEST((test("ELSE", no_case[lit("if") | lit("else")])));
+        BOOST_TEST((test("7", char_("a-z") | char_("0-9") | '_')));
+        BOOST_TEST((test("_", ~alpha | digit)));
+        BOOST_TEST((test("x", lit('a') | int_ | alpha)));
+        BOOST_TEST((test("", lit('a') | eps)));
+        BOOST_TEST((test("b1", (lit('a') >> int_) | (char_('b') >> int_))));
+
+        // the skipped alternatives leave the iterator where they would
+        // have left it after failing
+        BOOST_TEST((test("  b", lit('a') | no_skip[lit('b')], space)));
+        BOOST_TEST((!test("  b", (lit('a') >> 'c') | no_skip[lit('b')], space)));
+
+        std::string s;
+        BOOST_TEST((test_attr(" while", string("if") | string("while"), s, space)));
+        BOOST_TEST(s == "while");
+    }
+
+    {   // the bare char_ matches any character of its encoding
+        using boost::spirit::standard::char_;
+
+        BOOST_TEST((test("\xe9", lit('a') | char_)));
+        BOOST_TEST((test("\x7f", lit('a') | char_)));
+        BOOST_TEST((!test("", lit('a') | char_)));
+        BOOST_TEST((!test("\xe9", lit('a') | boost::spirit::ascii::char_)));
+    }
+
+#if !defined(BOOST_SPIRIT_QI_NO_FIRST_CHAR_DISPATCH)
+    {   // the jump table is not used for other than char input, and is
+        // shared by copies
+        using boost::spirit::compile;
+        using boost::spirit::qi::domain;
+
+        BOOST_TEST((test(L"b", lit(L'a') | lit(L'b'))));
+        BOOST_TEST((!test(L"c", lit(L'a') | lit(L'b'))));
+        BOOST_TEST((shares_first_char_table(
+            compile<domain>(lit('a') | lit('b')))));
+    }
+#endif
+
     return boost::report_errors();
 }
 
@@ -118,6 +118,14 @@ main()
         BOOST_TEST(!test("1", wide::char_(L"a-z")));
         BOOST_TEST(test("1", wide::char_(L"a-z0-9")));
 
+        // ranges crossing and beyond the first 256 characters
+        BOOST_TEST(test(L"\xff", wide::char_(L"\xf0-\x10f")));
+        BOOST_TEST(test(L"\x100", wide::char_(L"\xf0-\x10f")));
+        BOOST_TEST(!test(L"\x110", wide::char_(L"\xf0-\x10f")));
+        BOOST_TEST(!test(L"\xef", wide::char_(L"\xf0-\x10f")));
+        BOOST_TEST(test(L"\x3b1", wide::char_(L"a-z\x3b1-\x3c9")));
+        BOOST_TEST(!test(L"\x3b0", wide::char_(L"a-z\x3b1-\x3c9")));
+
         std::string set = "a-z0-9";
         BOOST_TEST(test("x", ascii::char_(set)));
 
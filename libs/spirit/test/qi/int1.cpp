@@ -93,6 +93,53 @@ main()
     }
 #endif
 
+    ///////////////////////////////////////////////////////////////////////////
+    //  long digit runs (converted in blocks from contiguous input)
+    ///////////////////////////////////////////////////////////////////////////
+    {
+        using boost::spirit::int_;
+        int i;
+
+        BOOST_TEST(test_attr("00000000000000000123456789", int_, i));
+        BOOST_TEST(i == 123456789);
+        BOOST_TEST(test_attr("-00000000000000000123456789", int_, i));
+        BOOST_TEST(i == -123456789);
+        BOOST_TEST(test_attr("-12345678 87654321", int_, i, false));
+        BOOST_TEST(i == -12345678);
+        BOOST_TEST(test_attr("-0000000000000002147483648", int_, i));
+        BOOST_TEST(i == INT_MIN);
+        BOOST_TEST(test_attr("-2147483647,", int_, i, false));
+        BOOST_TEST(i == INT_MIN + 1);
+        BOOST_TEST(test_attr("2147483647 1234567", int_, i, false));
+        BOOST_TEST(i == INT_MAX);
+        BOOST_TEST(!test("-0000000000000002147483649", int_));
+        BOOST_TEST(!test("-2147483649 1234567", int_, false));
+        BOOST_TEST(!test("2147483648 1234567", int_, false));
+        BOOST_TEST(!test("-123456789012345678901234", int_));
+    }
+
+#ifdef BOOST_HAS_LONG_LONG
+    {
+        using boost::spirit::long_long;
+        boost::long_long_type ll;
+
+        BOOST_TEST(test_attr("1234567890123456,", long_long, ll, false));
+        BOOST_TEST(ll == 1234567890123456LL);
+        BOOST_TEST(test_attr("-1234567890123456,", long_long, ll, false));
+        BOOST_TEST(ll == -1234567890123456LL);
+        BOOST_TEST(test_attr("-9223372036854775807", long_long, ll));
+        BOOST_TEST(ll == LONG_LONG_MIN + 1);
+        BOOST_TEST(test_attr("-9223372036854775808,", long_long, ll, false));
+        BOOST_TEST(ll == LONG_LONG_MIN);
+        BOOST_TEST(test_attr("-00000000009223372036854775808", long_long, ll));
+        BOOST_TEST(ll == LONG_LONG_MIN);
+        BOOST_TEST(!test("-9223372036854775809,", long_long, false));
+        BOOST_TEST(!test("9223372036854775808,", long_long, false));
+        BOOST_TEST(!test("-92233720368547758080", long_long));
+        BOOST_TEST(!test("92233720368547758070", long_long));
+    }
+#endif
+
     ///////////////////////////////////////////////////////////////////////////
     //  short_ and long_ tests
     ///////////////////////////////////////////////////////////////////////////
@@ -9,6 +9,7 @@
 =============================================================================*/
 
 #include "real.hpp"
+#include <string>
 
 int
 main()
@@ -99,6 +100,13 @@ main()
         BOOST_TEST(test_attr("NAN(...)", udouble, d)
                 && FP_NAN == fpclassify(d));
 
+        // very long mantissas
+        std::string const zeros(400, '0');
+        BOOST_TEST(test_attr(("1" + zeros).c_str(), udouble, d)
+                && FP_INFINITE == fpclassify(d));
+        BOOST_TEST(test(("1" + zeros + "e-390").c_str(), udouble));
+        BOOST_TEST(test(("0." + std::string(400, '1')).c_str(), udouble));
+
         BOOST_TEST(!test("e3", udouble));
         BOOST_TEST(!test_attr("e3", udouble, d));
 
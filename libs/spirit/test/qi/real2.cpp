@@ -9,6 +9,7 @@
 =============================================================================*/
 
 #include "real.hpp"
+#include <string>
 
 int
 main()
@@ -98,5 +99,31 @@ main()
             FP_NAN == fpclassify(d) && signbit(d));
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    //  very long mantissas (the digits are accumulated without an overflow
+    //  check, the result saturates to infinity)
+    ///////////////////////////////////////////////////////////////////////////
+    {
+        using boost::spirit::qi::double_;
+        using boost::math::fpclassify;
+        using boost::spirit::detail::signbit;   // Boost version is broken
+
+        std::string const zeros(400, '0');
+        std::string const ones(400, '1');
+        double d;
+
+        BOOST_TEST(test_attr(("1" + zeros).c_str(), double_, d) &&
+            FP_INFINITE == fpclassify(d) && !signbit(d));
+        BOOST_TEST(test_attr(("-1" + zeros).c_str(), double_, d) &&
+            FP_INFINITE == fpclassify(d) && signbit(d));
+        BOOST_TEST(test(("1" + zeros + "e-390").c_str(), double_));
+        BOOST_TEST(test(("0." + ones).c_str(), double_));
+        BOOST_TEST(test(("1" + zeros + "." + ones).c_str(), double_));
+        BOOST_TEST(test_attr(("0." + zeros + "1e401").c_str(), double_, d) &&
+            compare(d, 1.0));
+        BOOST_TEST(test_attr(std::string(30, '9').c_str(), double_, d) &&
+            compare(d / 1e30, 1.0));
+    }
+
     return boost::report_errors();
 }
@@ -10,6 +10,54 @@
 
 #include "real.hpp"
 
+///////////////////////////////////////////////////////////////////////////////
+//  policies implementing the interface without deriving from ureal_policies,
+//  the correctly_rounded flag is optional
+template <typename T>
+struct forwarding_real_policies
+{
+    typedef boost::spirit::qi::real_policies<T> base;
+
+    static bool const allow_leading_dot = true;
+    static bool const allow_trailing_dot = true;
+    static bool const expect_dot = false;
+
+    template <typename Iterator>
+    static bool parse_sign(Iterator& first, Iterator const& last)
+    { return base::parse_sign(first, last); }
+
+    template <typename Iterator, typename Attribute>
+    static bool parse_n(Iterator& first, Iterator const& last, Attribute& attr)
+    { return base::parse_n(first, last, attr); }
+
+    template <typename Iterator>
+    static bool parse_dot(Iterator& first, Iterator const& last)
+    { return base::parse_dot(first, last); }
+
+    template <typename Iterator, typename Attribute>
+    static bool parse_frac_n(Iterator& first, Iterator const& last
+      , Attribute& attr)
+    { return base::parse_frac_n(first, last, attr); }
+
+    template <typename Iterator>
+    static bool parse_exp(Iterator& first, Iterator const& last)
+    { return base::parse_exp(first, last); }
+
+    template <typename Iterator>
+    static bool parse_exp_n(Iterator& first, Iterator const& last, int& attr)
+    { return base::parse_exp_n(first, last, attr); }
+
+    template <typename Iterator, typename Attribute>
+    static bool parse_nan(Iterator& first, Iterator const& last
+      , Attribute& attr)
+    { return base::parse_nan(first, last, attr); }
+
+    template <typename Iterator, typename Attribute>
+    static bool parse_inf(Iterator& first, Iterator const& last
+      , Attribute& attr)
+    { return base::parse_inf(first, last, attr); }
+};
+
 int
 main()
 {
@@ -133,5 +181,78 @@ main()
         BOOST_TEST(!test("1.2e3", lit(ref(m))));
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    //  correctly rounded real number tests
+    ///////////////////////////////////////////////////////////////////////////
+    {
+        using boost::spirit::qi::real_parser;
+        using boost::spirit::qi::exact_real_policies;
+        using boost::spirit::qi::exact_ureal_policies;
+        using boost::math::fpclassify;
+
+        real_parser<double, exact_real_policies<double> > exact_double;
+        real_parser<float, exact_real_policies<float> > exact_float;
+        real_parser<double, exact_ureal_policies<double> > exact_udouble;
+
+        char const* inputs[] =
+        {
+            "0", "-0.0", "1", "1.", ".5", "-1.2e3", "0.1", "1e23",
+            "9007199254740993",                         // halfway, rounds down
+            "9007199254740993.0000000000000000001",     // just above halfway
+            "9007199254740995",                         // halfway, rounds up
+            "2.2250738585072011e-308",                  // largest subnormal
+            "4.9406564584124654e-324",                  // smallest subnormal
+            "2.4703282292062327e-324",                  // below half of it
+            "2.4703282292062328e-324",                  // above half of it
+            "1.7976931348623157e308",
+            "1.7976931348623158e308",                   // rounds to max
+            "1.7976931348623159e308",                   // overflows
+            "1e-400", "1e400", "0e999999999",
+            "123456789012345678901234567890e-10",
+            "0.000000000000000000000000000001234567890123456789012345",
+            "1.00000005960464477539062499",             // float halfway - 1
+            "1.000000059604644775390625",               // float halfway
+            "1.00000005960464477539062501"              // float halfway + 1
+        };
+
+        for (std::size_t i = 0; i < sizeof(inputs)/sizeof(inputs[0]); ++i)
+        {
+            double d = 0;
+            BOOST_TEST(test_attr(inputs[i], exact_double, d));
+            BOOST_TEST(d == std::strtod(inputs[i], 0));
+
+            float f = 0;
+            BOOST_TEST(test_attr(inputs[i], exact_float, f));
+#if defined(BOOST_SPIRIT_HAS_STRTOF)
+            BOOST_TEST(f == ::strtof(inputs[i], 0));
+#endif
+        }
+
+        double d = 0;
+        BOOST_TEST(test_attr("-inf", exact_double, d) &&
+            FP_INFINITE == fpclassify(d));
+        BOOST_TEST(test_attr("-nan", exact_double, d) &&
+            FP_NAN == fpclassify(d));
+        BOOST_TEST(test_attr("1.2e3", exact_udouble, d) && d == 1.2e3);
+        BOOST_TEST(!test("-1.2e3", exact_udouble));
+        BOOST_TEST(!test("1.2e", exact_double));
+        BOOST_TEST(!test(".", exact_double));
+        BOOST_TEST(!test("e3", exact_double));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  policies without the correctly_rounded flag
+    ///////////////////////////////////////////////////////////////////////////
+    {
+        using boost::spirit::qi::real_parser;
+
+        real_parser<double, forwarding_real_policies<double> > fwd_double;
+        double d = 0;
+
+        BOOST_TEST(test_attr("-1.2e3", fwd_double, d) && compare(d, -1.2e3));
+        BOOST_TEST(test_attr(".5", fwd_double, d) && compare(d, .5));
+        BOOST_TEST(!test("e3", fwd_double));
+    }
+
     return boost::report_errors();
 }
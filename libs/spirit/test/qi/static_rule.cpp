@@ -0,0 +1,125 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/spirit/include/qi_operator.hpp>
+#include <boost/spirit/include/qi_char.hpp>
+#include <boost/spirit/include/qi_string.hpp>
+#include <boost/spirit/include/qi_numeric.hpp>
+#include <boost/spirit/include/qi_directive.hpp>
+#include <boost/spirit/include/qi_nonterminal.hpp>
+#include <boost/spirit/include/qi_action.hpp>
+#include <boost/spirit/include/phoenix_core.hpp>
+#include <boost/spirit/include/phoenix_operator.hpp>
+#include <boost/typeof/typeof.hpp>
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include "test.hpp"
+
+int
+main()
+{
+    using spirit_test::test_attr;
+    using spirit_test::test;
+
+    using namespace boost::spirit::ascii;
+    using namespace boost::spirit::qi::labels;
+    using boost::spirit::qi::locals;
+    using boost::spirit::qi::rule;
+    using boost::spirit::qi::static_rule;
+    using boost::spirit::qi::make_static_rule;
+    using boost::spirit::qi::int_;
+    using boost::spirit::qi::lit;
+
+    { // basic tests
+
+        BOOST_AUTO(a, make_static_rule<char const*>(lit('a'), "a"));
+        BOOST_AUTO(b, make_static_rule<char const*>(lit('b'), "b"));
+        BOOST_AUTO(ab, make_static_rule<char const*>(a >> b));
+        rule<char const*> start = *(ab | 'c');
+
+        BOOST_TEST(test("ab", ab));
+        BOOST_TEST(!test("ba", ab));
+        BOOST_TEST(test("abcabcc", start));
+        BOOST_TEST(!test("abcacb", start));
+
+        BOOST_TEST(a.name() == "a");
+        BOOST_TEST(ab.name() == "unnamed-rule");
+
+        // a copy refers to its own right hand side
+        static_rule<char const*, BOOST_TYPEOF(a >> b)> ab2(ab);
+        BOOST_TEST(test("ab", ab2));
+        BOOST_TEST(test("abab", ab2 >> ab));
+    }
+
+    { // attributes
+
+        BOOST_AUTO(number, (make_static_rule<char const*, int()>(int_)));
+        BOOST_AUTO(twice,
+            (make_static_rule<char const*, int()>(number[_val = _1 * 2])));
+
+        int i = 0;
+        BOOST_TEST(test_attr("123", number, i) && i == 123);
+        BOOST_TEST(test_attr("21", twice, i) && i == 42);
+
+        std::vector<int> v;
+        BOOST_TEST(test_attr("1,2,3", number % ',', v) &&
+            v.size() == 3 && v[0] == 1 && v[1] == 2 && v[2] == 3);
+    }
+
+    { // skipper
+
+        BOOST_AUTO(numbers, (make_static_rule<
+            char const*, std::vector<int>(), space_type>(int_ % ',')));
+
+        std::vector<int> v;
+        BOOST_TEST(test_attr(" 1 , 2 ,3 ", numbers, v, space) &&
+            v.size() == 3 && v[2] == 3);
+
+        // without a skipper, the rule is an implied lexeme as a qi::rule
+        BOOST_AUTO(word, (make_static_rule<char const*, std::string()>(
+            +alpha)));
+        rule<char const*, std::string()> word_rule = +alpha;
+
+        std::string s;
+        BOOST_TEST(test_attr(" ab cd", word, s, space, false) && s == "ab");
+        s.clear();
+        BOOST_TEST(test_attr(" ab cd", word_rule, s, space, false) &&
+            s == "ab");
+        BOOST_TEST(!test("ab cd", word, space));
+        BOOST_TEST(!test("ab cd", word_rule, space));
+        BOOST_TEST(test("ab cd", word >> word, space));
+    }
+
+    { // inherited attributes and locals
+
+        BOOST_AUTO(exactly, (make_static_rule<char const*, void(int)>(
+            int_(_r1))));
+        BOOST_AUTO(pair, (make_static_rule<char const*, locals<char> >(
+            alpha[_a = _1] >> char_(_a))));
+
+        BOOST_TEST(test("5", exactly(5)));
+        BOOST_TEST(!test("5", exactly(6)));
+        BOOST_TEST(test("aa", pair));
+        BOOST_TEST(!test("ab", pair));
+    }
+
+    { // recursion is broken by a rule
+
+        rule<char const*, int()> sum;
+        BOOST_AUTO(term, (make_static_rule<char const*, int()>(
+            int_ | '(' >> sum >> ')')));
+        sum = term[_val = _1] >> *('+' >> term[_val += _1]);
+
+        int i = 0;
+        BOOST_TEST(test_attr("1+(2+3)+((4))", sum, i) && i == 10);
+        BOOST_TEST(!test("1+(2+3", sum));
+    }
+
+    return boost::report_errors();
+}
@@ -6,6 +6,8 @@
 =============================================================================*/
 #include <boost/detail/lightweight_test.hpp>
 #include <boost/spirit/include/qi_string.hpp>
+#include <boost/spirit/home/qi/string/flat_tst.hpp>
+#include <boost/spirit/home/qi/string/perfect_hash.hpp>
 #include <boost/spirit/include/qi_char.hpp>
 #include <boost/spirit/include/qi_action.hpp>
 #include <boost/spirit/include/qi_auxiliary.hpp>
@@ -133,6 +135,79 @@ main()
         BOOST_TEST((test("Joelyo", no_case[sym] >> "yo")));
     }
 
+    { // frozen flat_tst lookup
+        using namespace boost::spirit::ascii;
+        using boost::spirit::qi::flat_tst;
+
+        symbols<char, int, flat_tst<char, int> > sym;
+        // NOTE: make sure all entries are in lower-case!!!
+        sym.add
+            ("joel", 1)
+            ("ruby", 2)
+            ("tenji", 3)
+            ("tutit", 4)
+            ("kim", 5)
+            ("joey", 6)
+        ;
+        sym.lookup->freeze();
+
+        int i = 0;
+        BOOST_TEST((test_attr("tenji", sym, i)));
+        BOOST_TEST(i == 3);
+        BOOST_TEST((test_attr("JOEY", no_case[sym], i)));
+        BOOST_TEST(i == 6);
+        BOOST_TEST((test("Kimyo", no_case[sym] >> "yo")));
+        BOOST_TEST((!test("XXX", sym)));
+
+        sym.at("joel") = 7;                     // existing entry, stays frozen
+        BOOST_TEST(sym.lookup->frozen());
+        BOOST_TEST((test_attr("joel", sym, i)));
+        BOOST_TEST(i == 7);
+
+        sym.remove("kim");
+        BOOST_TEST((!test("kim", sym)));
+        BOOST_TEST((test("joel", sym)));
+    }
+
+    { // perfect_hash lookup
+        using namespace boost::spirit::ascii;
+        using boost::spirit::qi::perfect_hash;
+
+        symbols<char, int, perfect_hash<char, int> > sym;
+        // NOTE: make sure all entries are in lower-case!!!
+        sym.add
+            ("joel", 1)
+            ("ruby", 2)
+            ("tenji", 3)
+            ("tutit", 4)
+            ("kim", 5)
+            ("joey", 6)
+        ;
+        sym.lookup->freeze();
+
+        int i = 0;
+        BOOST_TEST((test_attr("tutit", sym, i)));
+        BOOST_TEST(i == 4);
+        BOOST_TEST((test_attr("RUBY", no_case[sym], i)));
+        BOOST_TEST(i == 2);
+        BOOST_TEST((test("Joelyo", no_case[sym] >> "yo")));
+        BOOST_TEST((!test("XXX", sym)));
+        BOOST_TEST((sym.find("joey") != 0 && *sym.find("joey") == 6));
+        char const* first = "kimmy";
+        BOOST_TEST((sym.prefix_find(first, first + 5) != 0));
+        BOOST_TEST((*first == 'm'));
+
+        sym.at("joey") = 8;                     // existing entry, stays frozen
+        BOOST_TEST(sym.lookup->frozen());
+        BOOST_TEST((test_attr("joey", sym, i)));
+        BOOST_TEST(i == 8);
+
+        sym.at("bob") = 7;
+        BOOST_TEST(!sym.lookup->frozen());
+        BOOST_TEST((test_attr("bob", sym, i)));
+        BOOST_TEST(i == 7);
+    }
+
     { // attributes
         symbols<char, int> sym;
 
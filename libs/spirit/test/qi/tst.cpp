@@ -7,6 +7,8 @@
 #include <boost/detail/lightweight_test.hpp>
 #include <boost/spirit/home/qi/string/tst.hpp>
 #include <boost/spirit/home/qi/string/tst_map.hpp>
+#include <boost/spirit/home/qi/string/flat_tst.hpp>
+#include <boost/spirit/home/qi/string/perfect_hash.hpp>
 
 #include <string>
 #include <cctype>
@@ -89,6 +91,29 @@ namespace
     }
 }
 
+// a lookup which is frozen again after every modification
+template <typename Base>
+struct frozen : Base
+{
+    typedef Base base_type;
+    typedef typename Base::value_type T;
+
+    template <typename Iterator>
+    T* add(Iterator first, Iterator last, T const& val)
+    {
+        T* result = this->base_type::add(first, last, val);
+        this->freeze();
+        return result;
+    }
+
+    template <typename Iterator>
+    void remove(Iterator first, Iterator last)
+    {
+        this->base_type::remove(first, last);
+        this->freeze();
+    }
+};
+
 template <typename Lookup, typename WideLookup>
 void tests()
 {
@@ -345,9 +370,108 @@ int main()
 {
     using boost::spirit::qi::tst;
     using boost::spirit::qi::tst_map;
+    using boost::spirit::qi::flat_tst;
+    using boost::spirit::qi::perfect_hash;
 
     tests<tst<char, int>, tst<wchar_t, int> >();
     tests<tst_map<char, int>, tst_map<wchar_t, int> >();
+    tests<flat_tst<char, int>, flat_tst<wchar_t, int> >();
+    tests<frozen<flat_tst<char, int> >, frozen<flat_tst<wchar_t, int> > >();
+    tests<perfect_hash<char, int>, perfect_hash<wchar_t, int> >();
+    tests<frozen<perfect_hash<char, int> >, frozen<perfect_hash<wchar_t, int> > >();
+
+    { // flat_tst specific tests
+        flat_tst<char, int> lookup;
+        add(lookup, "pineapple", 1);
+        add(lookup, "\xe9t\xe9", 2);
+        add(lookup, "apple", 3);
+        add(lookup, "zebra", 4);
+        add(lookup, "a", 5);
+
+        BOOST_TEST(!lookup.frozen());
+        lookup.freeze();
+        BOOST_TEST(lookup.frozen());
+
+        docheck(lookup, "pineapple", true, 9, 1);
+        docheck(lookup, "\xe9t\xe9", true, 3, 2);    // 8 bit characters
+        docheck(lookup, "apples", true, 5, 3);
+        docheck(lookup, "zebra", true, 5, 4);
+        docheck(lookup, "ab", true, 1, 5);
+        docheck(lookup, "b", false);
+
+        flat_tst<char, int> copy(lookup);      // copies stay frozen
+        BOOST_TEST(copy.frozen());
+        docheck(copy, "apple", true, 5, 3);
+
+        add(lookup, "apple", 8);                // existing entries don't thaw
+        remove(lookup, "apricot");
+        BOOST_TEST(lookup.frozen());
+        docheck(lookup, "apple", true, 5, 3);
+
+        add(lookup, "banana", 6);               // modifying thaws
+        BOOST_TEST(!lookup.frozen());
+        docheck(lookup, "banana", true, 6, 6);
+        docheck(lookup, "zebra", true, 5, 4);
+
+        // the values found are the ones stored in the entries
+        lookup.freeze();
+        char const* s = "apple";
+        *lookup.find(s, s + 5) = 7;
+        lookup.thaw();
+        docheck(lookup, "apple", true, 5, 7);
+    }
+
+    { // perfect_hash specific tests
+        perfect_hash<char, int> lookup;
+        add(lookup, "if", 1);
+        add(lookup, "int", 2);
+        add(lookup, "integer", 3);
+        add(lookup, "\xe9t\xe9", 4);
+
+        BOOST_TEST(!lookup.frozen());
+        lookup.freeze();
+        BOOST_TEST(lookup.frozen());
+
+        docheck(lookup, "if", true, 2, 1);
+        docheck(lookup, "inte", true, 3, 2);     // longest match
+        docheck(lookup, "integers", true, 7, 3);
+        docheck(lookup, "\xe9t\xe9", true, 3, 4);    // 8 bit characters
+        docheck(lookup, "i", false);
+        docheck(lookup, "x", false);
+
+        perfect_hash<char, int> copy(lookup);  // copies stay frozen
+        BOOST_TEST(copy.frozen());
+        docheck(copy, "int", true, 3, 2);
+
+        add(lookup, "if", 5);                   // existing entries don't thaw
+        remove(lookup, "in");
+        BOOST_TEST(lookup.frozen());
+        docheck(lookup, "if", true, 2, 1);
+
+        remove(lookup, "int");                  // modifying thaws
+        BOOST_TEST(!lookup.frozen());
+        docheck(lookup, "inte", false);
+        docheck(lookup, "integer", true, 7, 3);
+
+        // many keys sharing prefixes, all of them found after freezing
+        lookup.clear();
+        std::string key;
+        for (int i = 0; i < 2000; ++i)
+        {
+            key = "k";
+            for (int n = i; n != 0; n /= 7)
+                key += char('a' + n % 7);
+            add(lookup, key.c_str(), i);
+        }
+        lookup.freeze();
+        for (int i = 0; i < 2000; ++i)
+        {
+            key = "k";
+            for (int n = i; n != 0; n /= 7)
+                key += char('a' + n % 7);
+            docheck(lookup, key.c_str(), true, key.size(), i);
+        }
+    }
 
     return boost::report_errors();
 }
@@ -33,6 +33,36 @@ main()
         BOOST_TEST(!test_attr(unsigned_overflow, uint_, u));
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    //  long digit runs (converted in blocks from contiguous input)
+    ///////////////////////////////////////////////////////////////////////////
+    {
+        using boost::spirit::qi::uint_;
+        unsigned u;
+
+        BOOST_TEST(test_attr("0000000000000123456789", uint_, u));
+        BOOST_TEST(u == 123456789);
+        BOOST_TEST(test_attr("1234567x12345678", uint_, u, false));
+        BOOST_TEST(u == 1234567);
+        BOOST_TEST(test_attr("12345678 87654321", uint_, u, false));
+        BOOST_TEST(u == 12345678);
+        BOOST_TEST(test_attr("4294967295 1234567", uint_, u, false));
+        BOOST_TEST(u == UINT_MAX);
+        BOOST_TEST(!test("4294967296 1234567", uint_, false));
+        BOOST_TEST(!test("123456789012345678901234", uint_));
+
+#ifdef BOOST_HAS_LONG_LONG
+        using boost::spirit::qi::ulong_long;
+        boost::ulong_long_type ull;
+
+        BOOST_TEST(test_attr("18446744073709551615", ulong_long, ull));
+        BOOST_TEST(ull == 18446744073709551615ULL);
+        BOOST_TEST(test_attr("1234567890123456,", ulong_long, ull, false));
+        BOOST_TEST(ull == 1234567890123456ULL);
+        BOOST_TEST(!test("18446744073709551616", ulong_long));
+#endif
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     //  binary tests
     ///////////////////////////////////////////////////////////////////////////
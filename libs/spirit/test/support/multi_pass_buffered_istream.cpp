@@ -0,0 +1,73 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/config/warning_disable.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#include <boost/spirit/include/support_multi_pass.hpp>
+#include <boost/spirit/include/qi_operator.hpp>
+#include <boost/spirit/include/qi_char.hpp>
+#include <boost/spirit/include/qi_string.hpp>
+#include <boost/spirit/include/qi_numeric.hpp>
+#include <boost/spirit/include/qi_parse.hpp>
+
+#include <string>
+#include <vector>
+#include <sstream>
+
+namespace qi = boost::spirit::qi;
+namespace ascii = boost::spirit::ascii;
+namespace policies = boost::spirit::iterator_policies;
+
+typedef boost::spirit::multi_pass<std::istream
+  , policies::default_policy<
+        policies::ref_counted, policies::no_check
+      , policies::buffered_istream, policies::split_std_deque>
+> iterator_type;
+
+int main()
+{
+    {   // whitespace is not skipped
+        std::istringstream in(" a b\n");
+        iterator_type first(in), last;
+
+        std::string s;
+        BOOST_TEST(qi::parse(first, last, *qi::char_, s) && first == last);
+        BOOST_TEST(s == " a b\n");
+    }
+
+    {   // empty input
+        std::istringstream in("");
+        iterator_type first(in), last;
+        BOOST_TEST(first == last);
+    }
+
+    {   // input spanning many blocks, backtracking over block boundaries
+        std::string input;
+        for (int i = 0; i != 3000; ++i)
+            input += (i % 3 == 2) ? "123;" : "456,";
+
+        std::istringstream in(input);
+        iterator_type first(in), last;
+
+        std::vector<int> v;
+        BOOST_TEST(qi::phrase_parse(first, last
+          , *((qi::int_ >> ';') | (qi::int_ >> ','))
+          , ascii::space, v) && first == last);
+        BOOST_TEST(v.size() == 3000 && v[0] == 456 && v[2] == 123);
+        BOOST_TEST(in.eof());
+    }
+
+    {   // reading stops at the first character which doesn't match
+        std::istringstream in("1234x");
+        iterator_type first(in), last;
+
+        int i = 0;
+        BOOST_TEST(qi::parse(first, last, qi::int_, i) && i == 1234);
+        BOOST_TEST(first != last && *first == 'x');
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,134 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/config/warning_disable.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#include <boost/spirit/include/support_multi_pass.hpp>
+#include <boost/spirit/include/qi_operator.hpp>
+#include <boost/spirit/include/qi_char.hpp>
+#include <boost/spirit/include/qi_string.hpp>
+#include <boost/spirit/include/qi_parse.hpp>
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iterator>
+
+namespace spirit = boost::spirit;
+namespace policies = boost::spirit::iterator_policies;
+
+///////////////////////////////////////////////////////////////////////////////
+// keeps track of the number of buffered elements
+struct counted
+{
+    counted(int value_ = 0) : value(value_) { ++instances; }
+    counted(counted const& rhs) : value(rhs.value) { ++instances; }
+    ~counted() { --instances; }
+
+    int value;
+    static int instances;
+};
+
+int counted::instances = 0;
+
+// there is no end iterator for this input, the tests count the elements
+typedef std::vector<counted>::const_iterator base_iterator;
+typedef spirit::multi_pass<base_iterator
+  , policies::default_policy<
+        policies::ref_counted, policies::no_check
+      , policies::input_iterator, policies::chunked_queue<4> >
+> counted_iterator;
+
+typedef spirit::multi_pass<std::istreambuf_iterator<char>
+  , policies::default_policy<
+        policies::ref_counted, policies::no_check
+      , policies::buffering_input_iterator, policies::chunked_queue<4> >
+> stream_iterator;
+
+int main()
+{
+    std::vector<counted> input;
+    for (int i = 0; i != 100; ++i)
+        input.push_back(counted(i));
+    int const stored = counted::instances;
+
+    {   // held copies see the data they point to, no matter how far the
+        // foremost iterator got
+        counted_iterator first(input.begin());
+
+        counted_iterator held = first;
+        std::vector<counted_iterator> marks;
+        for (int i = 0; i != 100; ++i, ++first)
+        {
+            BOOST_TEST((*first).value == i);
+            if (i % 7 == 0)
+                marks.push_back(first);
+        }
+
+        BOOST_TEST((*held).value == 0);
+        for (std::size_t i = 0; i != marks.size(); ++i)
+        {
+            BOOST_TEST((*marks[i]).value == int(i * 7));
+            BOOST_TEST(held < marks[i] || i == 0);
+        }
+
+        for (int i = 0; held != first; ++held, ++i)
+            BOOST_TEST((*held).value == i);
+    }
+    BOOST_TEST(counted::instances == stored);
+
+    {   // a held copy moving along with the foremost iterator bounds the
+        // number of buffered elements
+        counted_iterator first(input.begin());
+
+        counted_iterator held = first;
+        for (int i = 0; i != 100; ++i, ++first)
+        {
+            if (i % 10 == 9)
+            {
+                held = first;
+                BOOST_TEST((*held).value == i);
+            }
+            BOOST_TEST(counted::instances - stored <= 16);
+        }
+    }
+    BOOST_TEST(counted::instances == stored);
+
+    {   // copies of an iterator which hasn't been used yet
+        counted_iterator first(input.begin());
+        counted_iterator copy1 = first;
+        counted_iterator copy2 = copy1;
+
+        std::advance(first, 50);
+        BOOST_TEST((*first).value == 50);
+        BOOST_TEST((*copy1).value == 0);
+        std::advance(copy1, 10);
+        BOOST_TEST((*copy1).value == 10);
+        BOOST_TEST((*copy2).value == 0);
+
+        // clear_queue leaves the other iterators intact
+        first.clear_queue();
+        BOOST_TEST((*first).value == 50);
+        BOOST_TEST((*copy2).value == 0);
+        ++first;
+        BOOST_TEST((*first).value == 51);
+    }
+    BOOST_TEST(counted::instances == stored);
+
+    {   // backtracking over chunk boundaries while parsing a stream
+        using boost::spirit::qi::lit;
+        using boost::spirit::qi::parse;
+
+        std::istringstream in("abcdefgh;abcdefgx;abcdefgh;");
+        stream_iterator first(std::istreambuf_iterator<char>(in.rdbuf()));
+        stream_iterator last;
+
+        BOOST_TEST(parse(first, last
+          , +(lit("abcdefgh;") | lit("abcdefgx;"))) && first == last);
+    }
+
+    return boost::report_errors();
+}
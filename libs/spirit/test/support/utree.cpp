@@ -423,5 +423,115 @@ int main()
         }
     }
 
+    {
+        // arena allocation
+        using boost::spirit::utree_arena;
+        using boost::spirit::utf8_symbol_type;
+
+        std::string const long_string(40, 'x');
+
+        utree_arena arena(1024);
+        BOOST_TEST(utree_arena::current() == 0);
+        BOOST_TEST(arena.capacity() == 0);
+
+        utree copy;
+        {
+            utree val;
+            {
+                utree_arena::scope scope(arena);
+                BOOST_TEST(utree_arena::current() == &arena);
+
+                for (int i = 0; i < 100; ++i)
+                {
+                    utree item;
+                    item.push_back(i);
+                    item.push_back(long_string);
+                    item.push_back(utf8_symbol_type("a-symbol"));
+                    val.push_back(item);
+                }
+                val.pop_front();
+                val.erase(val.begin());
+                val.insert(val.begin(), utree(long_string));
+                BOOST_TEST(arena.capacity() > 0);
+
+                {
+                    utree_arena inner;
+                    utree_arena::scope inner_scope(inner);
+                    BOOST_TEST(utree_arena::current() == &inner);
+                }
+                BOOST_TEST(utree_arena::current() == &arena);
+            }
+            BOOST_TEST(utree_arena::current() == 0);
+
+            // allocations outside of the scope use the heap again
+            std::size_t const capacity = arena.capacity();
+            val.push_back(long_string);
+            BOOST_TEST(arena.capacity() == capacity);
+
+            BOOST_TEST(val.size() == 100);
+            BOOST_TEST(val.front() == utree(long_string));
+            BOOST_TEST(val[1][0] == utree(2));
+            BOOST_TEST(val[1][1] == utree(long_string));
+            BOOST_TEST(check(val[98], "( 99 \"" + long_string + "\" a-symbol )"));
+
+            copy = val;
+        }
+
+        // the copy does not depend on the arena
+        BOOST_TEST(copy.size() == 100);
+        BOOST_TEST(copy.back() == utree(long_string));
+        BOOST_TEST(check(copy[98], "( 99 \"" + long_string + "\" a-symbol )"));
+    }
+
+    {
+        // indexed access to long lists
+        utree val;
+        for (int i = 0; i < 1000; ++i)
+            val.push_back(i);
+
+        utree const& cval = val;
+        BOOST_TEST(cval[500] == utree(500));
+        BOOST_TEST(val[999] == utree(999));
+
+        // the index follows push_back, pop_back, push_front and pop_front
+        val.push_back(1000);
+        BOOST_TEST(val[1000] == utree(1000));
+        val.pop_back();
+        val.pop_back();
+        BOOST_TEST(val.size() == 999);
+        BOOST_TEST(val[998] == utree(998));
+
+        // and is dropped by any other modification
+        val.pop_front();
+        BOOST_TEST(val[500] == utree(501));
+        val.push_front(0);
+        BOOST_TEST(val[500] == utree(500));
+        val.insert(val.begin(), -1);
+        BOOST_TEST(val[500] == utree(499));
+        val.erase(val.begin());
+        val.erase(val.begin());
+        BOOST_TEST(val[500] == utree(501));
+
+        utree::iterator it = val.begin();
+        std::advance(it, 100);
+        val.erase(it);
+        BOOST_TEST(val[100] == utree(102));
+        BOOST_TEST(val[500] == utree(502));
+
+        val[600] = utree(42);
+        BOOST_TEST(val[600] == utree(42));
+        BOOST_TEST(val.size() == 997);
+
+        utree copy = val;
+        BOOST_TEST(copy[600] == utree(42));
+        BOOST_TEST(copy == val);
+
+        while (val.size() > 1)
+            val.pop_back();
+        BOOST_TEST(val[0] == utree(1));
+        val.clear();
+        BOOST_TEST(copy[996] == utree(998));
+    }
+
     return boost::report_errors();
 }
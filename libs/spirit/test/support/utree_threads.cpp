@@ -0,0 +1,87 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Hartmut Kaiser
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+
+#define BOOST_SPIRIT_THREADSAFE
+
+#include <boost/config/warning_disable.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#include <boost/spirit/include/support_utree.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+
+#include <vector>
+
+using boost::spirit::utree;
+
+///////////////////////////////////////////////////////////////////////////////
+//  Reads all elements of the list through a const utree, in an order 
+//  depending on 'seed'. Indexed reads must not modify the list.
+void read_all(utree const& val, int seed, bool& ok)
+{
+    std::size_t const size = val.size();
+    for (int round = 0; round < 20; ++round)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            std::size_t const n = (i * 7919 + seed * 31 + round) % size;
+            if (val[n] != utree(int(n)))
+                ok = false;
+        }
+    }
+}
+
+void read_concurrently(utree const& val)
+{
+    std::size_t const count = 8;
+    boost::thread_group threads;
+    bool ok[count];
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        ok[i] = true;
+        threads.create_thread(
+            boost::bind(&read_all, boost::cref(val), int(i), boost::ref(ok[i])));
+    }
+    threads.join_all();
+
+    for (std::size_t i = 0; i < count; ++i)
+        BOOST_TEST(ok[i]);
+}
+
+int main()
+{
+    {
+        // a list built by push_back
+        utree val;
+        for (int i = 0; i < 2000; ++i)
+            val.push_back(i);
+        read_concurrently(val);
+    }
+
+    {
+        // a list built by push_front
+        utree val;
+        for (int i = 1999; i >= 0; --i)
+            val.push_front(i);
+        read_concurrently(val);
+    }
+
+    {
+        // a list which was modified in the middle
+        utree val;
+        for (int i = 0; i < 1999; ++i)
+            val.push_back(i < 1000 ? i : i + 1);
+
+        utree::iterator it = val.begin();
+        std::advance(it, 1000);
+        val.insert(it, 1000);
+        read_concurrently(val);
+    }
+
+    return boost::report_errors();
+}